@@ -0,0 +1,100 @@
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace {
+// Constant-initialized, so reading it from operator new never allocates itself
+thread_local AllocationStats counted;
+}
+
+#ifdef TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+    counted.count++;
+    counted.bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    counted.count++;
+    counted.bytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+// Over-aligned types (SpscQueue's indices, and Terrain which holds one) come through here
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    counted.count++;
+    counted.bytes += size;
+    // aligned_alloc wants a size that is a multiple of the alignment
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size, alignment);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return operator new(size, alignment, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif // TRACK_ALLOCATIONS
+
+AllocationStats threadAllocations() {
+    return counted;
+}
+
+void AllocationMeter::endFrame() {
+    AllocationStats now = threadAllocations();
+    if (now.count != last.count) {
+        total.count += now.count - last.count;
+        total.bytes += now.bytes - last.bytes;
+        allocatingFrames++;
+        lastAllocatingFrame = frames;
+    }
+    last = now;
+    frames++;
+}
+
+void AllocationMeter::print(const char* label) const {
+    std::cout << label << ": " << allocatingFrames << " of " << frames << " allocated (" << total.count
+              << " allocations, " << total.bytes << " bytes)";
+    if (allocatingFrames > 0) {
+        std::cout << ", last in frame " << lastAllocatingFrame;
+    }
+    std::cout << std::endl;
+}
\ No newline at end of file
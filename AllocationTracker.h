@@ -0,0 +1,38 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+// Heap allocation counting. Build with -DTRACK_ALLOCATIONS
+// (TRACK_ALLOCATIONS=1 bash run.sh) to replace the global operator new with
+// one that counts per thread; otherwise the counts stay at zero.
+
+#include <cstddef>
+
+struct AllocationStats {
+    unsigned long count = 0;
+    unsigned long bytes = 0;
+};
+
+// Allocations made through operator new by the calling thread so far
+AllocationStats threadAllocations();
+
+// Tallies how many frames (or steps) of one thread touched the heap
+class AllocationMeter {
+public:
+    // Call on the measured thread before its first frame
+    void begin() { last = threadAllocations(); }
+    // Call on the measured thread at the end of each frame
+    void endFrame();
+    // Prints e.g. "render frames: 3 of 5400 allocated (12 allocations, 4096 bytes), last in frame 41"
+    void print(const char* label) const;
+    unsigned long getFrames() const { return frames; }
+    unsigned long getAllocatingFrames() const { return allocatingFrames; }
+
+private:
+    AllocationStats last;
+    AllocationStats total;
+    unsigned long frames = 0;
+    unsigned long allocatingFrames = 0;
+    unsigned long lastAllocatingFrame = 0;
+};
+
+#endif // ALLOCATIONTRACKER_H
\ No newline at end of file
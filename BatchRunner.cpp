@@ -0,0 +1,85 @@
+#include "BatchRunner.h"
+#include "HeadlessRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+BatchRunner::BatchRunner(unsigned threadCount) : pool(threadCount) {
+    // Box2D registers its contact types lazily on the first contact it creates.
+    // Make that happen here, on one thread, before worlds are stepped in parallel.
+    ScriptedInput idle(0, 1);
+    HeadlessRunner warmup(idle, 120, 0);
+    warmup.run();
+}
+
+std::vector<RolloutResult> BatchRunner::run(const std::vector<RolloutSpec>& specs) {
+    std::vector<RolloutResult> results(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        pool.submit([&specs, &results, i] {
+            const RolloutSpec& spec = specs[i];
+            std::unique_ptr<InputSource> input = spec.makeInput();
+            auto runner = std::make_unique<HeadlessRunner>(*input, spec.maxSteps, spec.seed, spec.params);
+            HeadlessStats stats = runner->run();
+
+            RolloutResult& result = results[i];
+            result.distance = stats.distance;
+            result.flips = stats.score;
+            result.timeToCrash = stats.steps * PHYSICS_TIMESTEP;
+            result.crash = stats.crash;
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+void runParameterSweep(unsigned rollouts, unsigned threadCount, uint32_t seed, unsigned long maxSteps) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> scale(0.75f, 1.25f);
+    std::uniform_int_distribution<unsigned long> hold(10, 60);
+    std::uniform_int_distribution<unsigned long> release(0, 40);
+
+    std::vector<RolloutSpec> specs(rollouts);
+    for (auto& spec : specs) {
+        spec.params.maxSpeed = MAX_SPEED * scale(gen);
+        spec.params.accelerationForce = ACCELERATION_FORCE * scale(gen);
+        spec.params.rotationTorque = ROTATION_TORQUE * scale(gen);
+        spec.params.maxAngularVelocity = MAX_ANGULAR_VELOCITY * scale(gen);
+        spec.params.angularFriction = std::min(0.999f, ANGULAR_FRICTION * scale(gen));
+        spec.seed = gen();
+        spec.maxSteps = maxSteps;
+        unsigned long holdSteps = hold(gen);
+        unsigned long releaseSteps = release(gen);
+        spec.makeInput = [holdSteps, releaseSteps] {
+            return std::make_unique<ScriptedInput>(holdSteps, releaseSteps);
+        };
+    }
+
+    BatchRunner runner(threadCount);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<RolloutResult> results = runner.run(specs);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Rollouts:     " << rollouts << "\n"
+              << "Threads:      " << runner.getThreadCount() << "\n"
+              << "Wall time:    " << elapsed.count() << " s\n"
+              << "Rollouts/sec: " << rollouts / elapsed.count() << "\n\n";
+
+    std::vector<size_t> order(results.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&results](size_t a, size_t b) {
+        return results[a].distance > results[b].distance;
+    });
+    std::cout << "Best rollouts by distance:\n";
+    for (size_t k = 0; k < std::min<size_t>(5, order.size()); ++k) {
+        const BikeParams& p = specs[order[k]].params;
+        const RolloutResult& r = results[order[k]];
+        std::cout << "  distance " << r.distance << " m, flips " << r.flips
+                  << ", time " << r.timeToCrash << " s (" << crashReasonName(r.crash) << ")\n"
+                  << "    maxSpeed " << p.maxSpeed << ", accelerationForce " << p.accelerationForce
+                  << ", rotationTorque " << p.rotationTorque << ", maxAngularVelocity " << p.maxAngularVelocity
+                  << ", angularFriction " << p.angularFriction << "\n";
+    }
+    std::cout << std::flush;
+}
\ No newline at end of file
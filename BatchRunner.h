@@ -0,0 +1,45 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "Bicycle.h"
+#include "InputSource.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// One independent run: bike parameters, terrain seed and an input policy.
+// makeInput is called on the worker thread, so each rollout owns its policy.
+struct RolloutSpec {
+    BikeParams params;
+    uint32_t seed = 0;
+    unsigned long maxSteps = 3600;
+    std::function<std::unique_ptr<InputSource>()> makeInput;
+};
+
+struct RolloutResult {
+    float distance = 0.0f;
+    int flips = 0;
+    // Simulated seconds until the crash, or the full run length if it never crashed
+    float timeToCrash = 0.0f;
+    CrashReason crash = CrashReason::None;
+};
+
+// Runs many rollouts in parallel, each in its own b2World with nothing shared
+class BatchRunner {
+public:
+    // 0 threads means one per hardware core
+    explicit BatchRunner(unsigned threadCount = 0);
+    std::vector<RolloutResult> run(const std::vector<RolloutSpec>& specs);
+    unsigned getThreadCount() const { return pool.size(); }
+
+private:
+    ThreadPool pool;
+};
+
+// Randomly perturbs the bike constants around their defaults and reports the best sets
+void runParameterSweep(unsigned rollouts, unsigned threadCount, uint32_t seed, unsigned long maxSteps);
+
+#endif // BATCHRUNNER_H
\ No newline at end of file
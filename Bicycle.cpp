@@ -1,21 +1,28 @@
 #include "Bicycle.h"
+#include "ContactListener.h"
 #include <cmath>
 
-Bicycle::Bicycle(b2World* world) {
+Bicycle::Bicycle(b2World* world, const BikeParams& params) : params(params) {
     // Define the bike body in Box2D
     b2BodyDef bikeDef;
     bikeDef.type = b2_dynamicBody;
-    bikeDef.position.Set(100.0f / SCALE, 300.0f / SCALE);
+    bikeDef.position.Set(BIKE_START_X / SCALE, BIKE_START_Y / SCALE);
     bike = world->CreateBody(&bikeDef);
 
+    // Every part of the bike shares one filter so bikes pass through each other
+    b2Filter bikeFilter;
+    bikeFilter.categoryBits = BIKE_COLLISION_BITS;
+    bikeFilter.maskBits = GROUND_COLLISION_BITS;
+
     // Create the bike frame as a rectangle
     b2PolygonShape bikeFrameShape;
     bikeFrameShape.SetAsBox(30.0f / SCALE, 8.0f / SCALE);
     b2FixtureDef bikeFrameFixture;
     bikeFrameFixture.shape = &bikeFrameShape;
     bikeFrameFixture.density = 0.5f;
-    bikeFrameFixture.friction = FRICTION;
-    bikeFrameFixture.userData.pointer = 1; // 1 = frame
+    bikeFrameFixture.friction = params.friction;
+    bikeFrameFixture.filter = bikeFilter;
+    bikeFrameFixture.userData.pointer = static_cast<uintptr_t>(FixtureCategory::Frame);
     bike->CreateFixture(&bikeFrameFixture);
 
     // Create the front wheel as a circle
@@ -25,8 +32,9 @@ Bicycle::Bicycle(b2World* world) {
     b2FixtureDef frontWheelFixture;
     frontWheelFixture.shape = &frontWheelShape;
     frontWheelFixture.density = 0.3f;
-    frontWheelFixture.friction = FRICTION * 2;
-    frontWheelFixture.userData.pointer = 2; // 2 = wheel
+    frontWheelFixture.friction = params.friction * 2;
+    frontWheelFixture.filter = bikeFilter;
+    frontWheelFixture.userData.pointer = static_cast<uintptr_t>(FixtureCategory::Wheel);
     bike->CreateFixture(&frontWheelFixture);
 
     // Create the rear wheel as a circle
@@ -36,33 +44,52 @@ Bicycle::Bicycle(b2World* world) {
     b2FixtureDef rearWheelFixture;
     rearWheelFixture.shape = &rearWheelShape;
     rearWheelFixture.density = 0.3f;
-    rearWheelFixture.friction = FRICTION * 2;
-    rearWheelFixture.userData.pointer = 2; // 2 = wheel
+    rearWheelFixture.friction = params.friction * 2;
+    rearWheelFixture.filter = bikeFilter;
+    rearWheelFixture.userData.pointer = static_cast<uintptr_t>(FixtureCategory::Wheel);
     bike->CreateFixture(&rearWheelFixture);
 
-    // Set up SFML shapes for rendering
-    frontWheel = sf::CircleShape(15.0f);
-    frontWheel.setOrigin(15.0f, 10.0f);
-    frontWheel.setFillColor(sf::Color::Red);
-
-    rearWheel = sf::CircleShape(15.0f);
-    rearWheel.setOrigin(15.0f, 10.0f);
-    rearWheel.setFillColor(sf::Color::Red);
-
-    bikeFrame = sf::RectangleShape(sf::Vector2f(60.0f, 20.0f));
-    bikeFrame.setOrigin(30.0f, 15.0f);
-    bikeFrame.setFillColor(sf::Color::Blue);
-
     accumulatedAngle = 0.0f;
     lastAngle = 0.0f;
+    savePreviousState();
 }
 
 void Bicycle::reset() {
-    bike->SetTransform(b2Vec2(100.0f / SCALE, 300.0f / SCALE), 0.0f);
+    bike->SetTransform(b2Vec2(BIKE_START_X / SCALE, BIKE_START_Y / SCALE), 0.0f);
     bike->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
     bike->SetAngularVelocity(0.0f);
     accumulatedAngle = 0.0f;
     lastAngle = 0.0f;
+    savePreviousState();
+}
+
+void Bicycle::saveState(BikeState& out) const {
+    out.position = bike->GetPosition();
+    out.angle = bike->GetAngle();
+    out.linearVelocity = bike->GetLinearVelocity();
+    out.angularVelocity = bike->GetAngularVelocity();
+    out.accumulatedAngle = accumulatedAngle;
+    out.lastAngle = lastAngle;
+    out.enabled = bike->IsEnabled();
+}
+
+void Bicycle::restoreState(const BikeState& state) {
+    // Box2D brings the body's contacts up to date during the next step
+    if (bike->IsEnabled() != state.enabled) {
+        bike->SetEnabled(state.enabled);
+    }
+    bike->SetTransform(state.position, state.angle);
+    bike->SetLinearVelocity(state.linearVelocity);
+    bike->SetAngularVelocity(state.angularVelocity);
+    bike->SetAwake(true);
+    accumulatedAngle = state.accumulatedAngle;
+    lastAngle = state.lastAngle;
+    savePreviousState();
+}
+
+void Bicycle::savePreviousState() {
+    previousPosition = bike->GetPosition();
+    previousAngle = bike->GetAngle();
 }
 
 bool Bicycle::updatePhysics(bool spacePressed) {
@@ -71,22 +98,22 @@ bool Bicycle::updatePhysics(bool spacePressed) {
     if (spacePressed) {
         // If the bike is moving vertically, apply torque to rotate it
         if (std::abs(velocity.y) > 0.5f) {
-            bike->ApplyTorque(-ROTATION_TORQUE, true);
+            bike->ApplyTorque(-params.rotationTorque, true);
             float angularVelocity = bike->GetAngularVelocity();
-            if (angularVelocity < -MAX_ANGULAR_VELOCITY) {
-                bike->SetAngularVelocity(-MAX_ANGULAR_VELOCITY);
+            if (angularVelocity < -params.maxAngularVelocity) {
+                bike->SetAngularVelocity(-params.maxAngularVelocity);
             }
         }
         // Apply forward force if not at max speed
-        if (velocity.x < MAX_SPEED) {
-            bike->ApplyForceToCenter(b2Vec2(ACCELERATION_FORCE, 0.0f), true);
+        if (velocity.x < params.maxSpeed) {
+            bike->ApplyForceToCenter(b2Vec2(params.accelerationForce, 0.0f), true);
         }
     }
 
     if (!spacePressed) {
         // Apply angular friction to slow down rotation
         float currentAngularVel = bike->GetAngularVelocity();
-        bike->SetAngularVelocity(currentAngularVel * ANGULAR_FRICTION);
+        bike->SetAngularVelocity(currentAngularVel * params.angularFriction);
     }
 
     // --- Full rotation detection ---
@@ -102,33 +129,4 @@ bool Bicycle::updatePhysics(bool spacePressed) {
         return true;
     }
     return false;
-}
-
-void Bicycle::updateVisuals() {
-    // Update the SFML shapes to match the Box2D body
-    b2Vec2 pos = bike->GetPosition();
-    float angle = bike->GetAngle();
-
-    bikeFrame.setPosition(pos.x * SCALE, pos.y * SCALE);
-    bikeFrame.setRotation(angle * 180 / PI);
-
-    float cosAngle = cos(angle);
-    float sinAngle = sin(angle);
-
-    // Calculate wheel positions based on bike angle
-    float frontWheelOffsetX = 20.0f * cosAngle;
-    float frontWheelOffsetY = 20.0f * sinAngle;
-    frontWheel.setPosition(pos.x * SCALE + frontWheelOffsetX, pos.y * SCALE + frontWheelOffsetY);
-    frontWheel.setRotation(angle * 180 / PI);
-
-    float rearWheelOffsetX = -20.0f * cosAngle;
-    float rearWheelOffsetY = -20.0f * sinAngle;
-    rearWheel.setPosition(pos.x * SCALE + rearWheelOffsetX, pos.y * SCALE + rearWheelOffsetY);
-    rearWheel.setRotation(angle * 180 / PI);
-}
-
-void Bicycle::render(sf::RenderWindow& window) {
-    window.draw(rearWheel);
-    window.draw(frontWheel);
-    window.draw(bikeFrame);
 }
\ No newline at end of file
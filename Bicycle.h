@@ -1,7 +1,6 @@
 #ifndef BICYCLE_H
 #define BICYCLE_H
 
-#include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
 const float SCALE = 30.0f;
@@ -12,25 +11,57 @@ const float FRICTION = 0.3f;
 const float ROTATION_TORQUE = 10.0f;
 const float MAX_ANGULAR_VELOCITY = 7.0f;
 const float ANGULAR_FRICTION = 0.95f;
+const float BIKE_START_X = 100.0f;
+const float BIKE_START_Y = 300.0f;
+
+// Tuning parameters of a bike; the constants above are the defaults
+struct BikeParams {
+    float maxSpeed = MAX_SPEED;
+    float accelerationForce = ACCELERATION_FORCE;
+    float friction = FRICTION;
+    float rotationTorque = ROTATION_TORQUE;
+    float maxAngularVelocity = MAX_ANGULAR_VELOCITY;
+    float angularFriction = ANGULAR_FRICTION;
+};
+
+// Everything that changes about a bike while it rides, for snapshots
+struct BikeState {
+    b2Vec2 position;
+    float angle = 0.0f;
+    b2Vec2 linearVelocity;
+    float angularVelocity = 0.0f;
+    float accumulatedAngle = 0.0f;
+    float lastAngle = 0.0f;
+    bool enabled = true;
+};
 
 class Bicycle {
 public:
-    Bicycle(b2World* world);
+    Bicycle(b2World* world, const BikeParams& params = BikeParams());
     void reset();
     // Returns true if a full rotation is completed this frame
     bool updatePhysics(bool spacePressed);
-    void updateVisuals();
-    void render(sf::RenderWindow& window);
+    // Remembers the current transform before a physics step, for interpolation
+    void savePreviousState();
+    void saveState(BikeState& out) const;
+    // Puts the body back exactly as saved, with nothing to interpolate from
+    void restoreState(const BikeState& state);
+    // Keeps the saved transform in step with b2World::ShiftOrigin, which moves only the body
+    void shiftOrigin(const b2Vec2& newOrigin) { previousPosition -= newOrigin; }
     b2Body* getBody() const { return bike; }
     b2Vec2 getPosition() const { return bike->GetPosition(); }
+    // Transform before the last physics step; the bike is drawn blended between
+    // this and the current one, through a RiderBatch
+    b2Vec2 getPreviousPosition() const { return previousPosition; }
+    float getPreviousAngle() const { return previousAngle; }
 
 private:
+    BikeParams params;
     b2Body* bike;
-    sf::CircleShape frontWheel;
-    sf::CircleShape rearWheel;
-    sf::RectangleShape bikeFrame;
     float accumulatedAngle = 0.0f;
     float lastAngle = 0.0f;
+    b2Vec2 previousPosition;
+    float previousAngle = 0.0f;
 };
 
 #endif // BICYCLE_H
\ No newline at end of file
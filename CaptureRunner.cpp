@@ -0,0 +1,48 @@
+#include "CaptureRunner.h"
+#include "FrameCapture.h"
+#include "SceneRenderer.h"
+#include "Simulation.h"
+#include <chrono>
+#include <iostream>
+
+bool runCapture(InputSource& input, uint32_t seed, unsigned ghostCount, unsigned long maxSteps,
+                const std::string& path) {
+    sf::RenderTexture target;
+    if (!target.create(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+        std::cerr << "Error: Could not create an offscreen render target (no OpenGL context; "
+                  << "without a display, try xvfb-run with LIBGL_ALWAYS_SOFTWARE=1)" << std::endl;
+        return false;
+    }
+    FrameCapture capture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!capture.open(path)) {
+        return false;
+    }
+
+    Simulation sim(seed, BikeParams(), true);
+    addScriptedGhosts(sim, ghostCount, seed);
+    SceneRenderer scene(ghostCount + 1);
+    RenderSnapshot snapshot;
+    CrashReason crash = CrashReason::None;
+    auto start = std::chrono::steady_clock::now();
+
+    // Each frame shows the state right after its step, so alpha is always 1
+    while (sim.getStepCount() < maxSteps && crash == CrashReason::None) {
+        sim.step(input.isSpacePressed(sim.getStepCount()));
+        crash = sim.checkCrash();
+        captureSnapshot(sim, snapshot);
+        if (snapshot.score != scene.getScore()) {
+            scene.setScore(snapshot.score);
+        }
+        scene.updateCamera(snapshot, 1.0f, PHYSICS_TIMESTEP);
+        scene.render(target, snapshot, 1.0f);
+        target.display();
+        capture.captureFrame(target, true);
+    }
+    capture.finish();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Rendered " << sim.getStepCount() << " frames in " << elapsed.count() << " s ("
+              << sim.getStepCount() / elapsed.count() << " frames/sec), crash: " << crashReasonName(crash)
+              << std::endl;
+    return true;
+}
\ No newline at end of file
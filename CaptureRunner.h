@@ -0,0 +1,16 @@
+#ifndef CAPTURERUNNER_H
+#define CAPTURERUNNER_H
+
+#include "InputSource.h"
+#include <cstdint>
+#include <string>
+
+// Renders a run to path without a window: one physics step per frame, drawn
+// by SceneRenderer into an offscreen texture and handed to FrameCapture,
+// which it waits on rather than dropping frames. Needs an OpenGL context but
+// no screen: on a machine without a display, run it inside xvfb-run with
+// Mesa's software renderer. Stops at the first crash or after maxSteps.
+bool runCapture(InputSource& input, uint32_t seed, unsigned ghostCount, unsigned long maxSteps,
+                const std::string& path);
+
+#endif // CAPTURERUNNER_H
\ No newline at end of file
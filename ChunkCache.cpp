@@ -0,0 +1,37 @@
+#include "ChunkCache.h"
+#include <algorithm>
+#include <utility>
+
+ChunkCache::ChunkCache(size_t capacity) : capacity(capacity) {
+    entries.reserve(capacity);
+}
+
+bool ChunkCache::take(int index, ChunkHandle& out) {
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [index](const Entry& entry) { return entry.chunk->index == index; });
+    if (it == entries.end()) {
+        return false;
+    }
+    // Order does not matter, so fill the hole with the last entry
+    out = std::move(it->chunk);
+    *it = std::move(entries.back());
+    entries.pop_back();
+    return true;
+}
+
+void ChunkCache::put(ChunkHandle chunk) {
+    // Replace any older copy, then evict the least recently stored
+    ChunkHandle stale;
+    take(chunk->index, stale);
+    if (entries.size() >= capacity) {
+        auto oldest = std::min_element(entries.begin(), entries.end(),
+                                       [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+        *oldest = std::move(entries.back());
+        entries.pop_back();
+    }
+    entries.push_back(Entry{std::move(chunk), ++useCounter});
+}
+
+void ChunkCache::clear() {
+    entries.clear();
+}
\ No newline at end of file
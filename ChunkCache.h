@@ -0,0 +1,33 @@
+#ifndef CHUNKCACHE_H
+#define CHUNKCACHE_H
+
+#include "TerrainGenerator.h"
+#include <cstddef>
+#include <vector>
+
+// Least-recently-used store of detached terrain chunks, so ground that comes
+// back into range is reattached without regenerating it. Holds at most
+// capacity chunks; anything older is dropped and regenerated when needed.
+// A linear scan over a few slots, reserved up front, so taking and storing
+// chunks never allocates.
+class ChunkCache {
+public:
+    explicit ChunkCache(size_t capacity);
+    // Moves the chunk out of the cache if it is there
+    bool take(int index, ChunkHandle& out);
+    void put(ChunkHandle chunk);
+    void clear();
+    size_t size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        ChunkHandle chunk;
+        unsigned long lastUsed;
+    };
+
+    size_t capacity;
+    std::vector<Entry> entries;
+    unsigned long useCounter = 0;
+};
+
+#endif // CHUNKCACHE_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "ContactListener.h"
+
+FixtureCategory fixtureCategory(b2Fixture* fixture) {
+    return static_cast<FixtureCategory>(fixture->GetUserData().pointer);
+}
+
+ContactListener::ContactListener() {
+    reserveRiders(1);
+}
+
+void ContactListener::reserveRiders(size_t riders) {
+    events.reserve(riders * EVENTS_PER_RIDER);
+}
+
+void ContactListener::grow() {
+    events.reserve(events.capacity() * 2);
+}
+
+void ContactListener::BeginContact(b2Contact* contact) {
+    push(contact, true);
+}
+
+void ContactListener::EndContact(b2Contact* contact) {
+    push(contact, false);
+}
+
+void ContactListener::clear() {
+    events.clear();
+    overflowed = false;
+}
+
+void ContactListener::push(b2Contact* contact, bool begin) {
+    // Only bike parts touching the ground are of interest
+    b2Fixture* bikeFixture = contact->GetFixtureA();
+    b2Fixture* other = contact->GetFixtureB();
+    if (fixtureCategory(bikeFixture) == FixtureCategory::Ground) {
+        bikeFixture = contact->GetFixtureB();
+        other = contact->GetFixtureA();
+    }
+    if (fixtureCategory(other) != FixtureCategory::Ground) {
+        return;
+    }
+
+    ContactKind kind;
+    switch (fixtureCategory(bikeFixture)) {
+        case FixtureCategory::Frame:
+            kind = ContactKind::FrameGround;
+            break;
+        case FixtureCategory::Wheel:
+            kind = ContactKind::WheelGround;
+            break;
+        default:
+            return;
+    }
+
+    if (events.size() == events.capacity()) {
+        overflowed = true;
+        return;
+    }
+    events.push_back(ContactEvent{kind, begin, bikeFixture->GetBody()});
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef CONTACTLISTENER_H
+#define CONTACTLISTENER_H
+
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What a fixture is, stored in its userData.pointer
+enum class FixtureCategory : uintptr_t {
+    None = 0,
+    Frame = 1,
+    Wheel = 2,
+    Ground = 3
+};
+
+FixtureCategory fixtureCategory(b2Fixture* fixture);
+
+// Collision filter bits: bikes collide with the ground but never with each other
+const uint16 GROUND_COLLISION_BITS = 0x0001;
+const uint16 BIKE_COLLISION_BITS = 0x0002;
+
+enum class ContactKind : uint8_t {
+    FrameGround,
+    WheelGround
+};
+
+struct ContactEvent {
+    ContactKind kind;
+    bool begin;
+    // The bike body involved, so many bikes can share one world
+    b2Body* body;
+};
+
+// Collects bike/ground BeginContact and EndContact events into a buffer
+// sized up front; clear() it before each step and read it after. If a step
+// produces more events than fit, the rest are lost and hasOverflowed() says
+// so: the reader must then recount contacts from the bodies and grow().
+class ContactListener : public b2ContactListener {
+public:
+    // Room per bike in one step, far above what three fixtures produce
+    static constexpr size_t EVENTS_PER_RIDER = 64;
+
+    ContactListener();
+    void BeginContact(b2Contact* contact) override;
+    void EndContact(b2Contact* contact) override;
+    void clear();
+    // Grows the buffer for this many bikes sharing the world; call outside a step
+    void reserveRiders(size_t riders);
+
+    // Doubles the buffer after an overflow; call outside a step
+    void grow();
+
+    const ContactEvent* begin() const { return events.data(); }
+    const ContactEvent* end() const { return events.data() + events.size(); }
+    bool hasOverflowed() const { return overflowed; }
+
+private:
+    // Never grows during a step: events past the reserved capacity are dropped
+    std::vector<ContactEvent> events;
+    bool overflowed = false;
+
+    void push(b2Contact* contact, bool begin);
+};
+
+#endif // CONTACTLISTENER_H
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "FrameCapture.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+bool endsWith(const std::string& text, const char* suffix) {
+    std::string tail(suffix);
+    return text.size() >= tail.size() && text.compare(text.size() - tail.size(), tail.size(), tail) == 0;
+}
+
+// The pattern becomes a printf format, so it may hold exactly one %d or %0Nd and no other %
+bool isFramePattern(const std::string& pattern) {
+    size_t percent = pattern.find('%');
+    if (percent == std::string::npos || pattern.find('%', percent + 1) != std::string::npos) {
+        return false;
+    }
+    size_t i = percent + 1;
+    if (i < pattern.size() && pattern[i] == '0') {
+        ++i;
+    }
+    while (i < pattern.size() && pattern[i] >= '0' && pattern[i] <= '9') {
+        ++i;
+    }
+    return i < pattern.size() && pattern[i] == 'd';
+}
+
+uint8_t clampByte(int value) {
+    return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+}
+
+FrameCapture::FrameCapture(unsigned width, unsigned height, unsigned workerCount)
+    : width(width)
+    , height(height)
+    , workerCount(std::max(workerCount, 1u))
+{
+}
+
+FrameCapture::~FrameCapture() {
+    finish();
+}
+
+bool FrameCapture::open(const std::string& outputPath) {
+    // Pick the format from the extension, then allocate every buffer before the first frame
+    path = outputPath;
+    if (endsWith(path, ".y4m")) {
+        format = Format::Y4m;
+        video.open(path, std::ios::binary);
+        if (!video) {
+            std::cerr << "Error: Could not write capture " << path << std::endl;
+            return false;
+        }
+        video << "YUV4MPEG2 W" << width << " H" << height << " F" << CAPTURE_FPS
+              << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+    } else if (endsWith(path, ".png") && isFramePattern(path)) {
+        format = Format::Png;
+    } else {
+        std::cerr << "Error: Capture path must end in .y4m, or be a .png pattern with one %d or %0Nd "
+                  << "and no other %, such as frames/%05d.png" << std::endl;
+        return false;
+    }
+
+    size_t chromaSize = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    slots.resize(CAPTURE_BUFFERS);
+    for (std::unique_ptr<Slot>& slot : slots) {
+        slot.reset(new Slot());
+        slot->pixels.resize(static_cast<size_t>(width) * height * 4);
+        if (format == Format::Y4m) {
+            slot->encoded.resize(static_cast<size_t>(width) * height + 2 * chromaSize);
+        }
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&FrameCapture::workerLoop, this);
+    }
+    std::cout << "Capturing to " << path << std::endl;
+    return true;
+}
+
+bool FrameCapture::captureFrame(sf::RenderTexture& target, bool waitForBuffer) {
+    // Only the readback happens on the caller's thread; conversion and writing are left to the workers
+    if (workers.empty()) {
+        return false;
+    }
+    Slot& slot = *slots[framesQueued % slots.size()];
+    if (slot.state.load(std::memory_order_acquire) != SlotState::Free) {
+        if (!waitForBuffer) {
+            framesDropped++;
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&slot] { return slot.state.load() == SlotState::Free; });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!target.setActive(true)) {
+        framesDropped++;
+        return false;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE,
+                 slot.pixels.data());
+    readback.record(std::chrono::steady_clock::now() - start);
+
+    slot.frame = framesQueued;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot.state.store(SlotState::Filled, std::memory_order_release);
+        framesQueued++;
+    }
+    changed.notify_all();
+    return true;
+}
+
+void FrameCapture::finish() {
+    if (workers.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    video.close();
+
+    std::cout << "Captured " << framesWritten << " frames to " << path << " (" << framesDropped << " dropped";
+    if (writeErrors > 0) {
+        std::cout << ", " << writeErrors << " failed to write";
+    }
+    std::cout << ")" << std::endl;
+    if (readback.getCount() > 0) {
+        readback.print("Capture readback");
+    }
+}
+
+void FrameCapture::workerLoop() {
+    // Claim frame numbers in order and encode each outside the lock; a Y4M frame is
+    // appended only once every earlier frame has been
+    while (true) {
+        unsigned long frame = nextToEncode.fetch_add(1);
+        Slot& slot = *slots[frame % slots.size()];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this, &slot, frame] {
+                return (slot.state.load() == SlotState::Filled && slot.frame == frame) ||
+                       (stopping && frame >= framesQueued);
+            });
+            if (slot.state.load() != SlotState::Filled || slot.frame != frame) {
+                return;
+            }
+        }
+
+        bool ok = true;
+        if (format == Format::Y4m) {
+            convertToYuv(slot, slot.encoded);
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this, frame] { return framesWritten == frame; });
+            }
+            video << "FRAME\n";
+            video.write(reinterpret_cast<const char*>(slot.encoded.data()), slot.encoded.size());
+            ok = static_cast<bool>(video);
+        } else {
+            ok = writePng(slot);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            framesWritten++;
+            if (!ok) {
+                writeErrors++;
+            }
+            slot.state.store(SlotState::Free, std::memory_order_release);
+        }
+        changed.notify_all();
+    }
+}
+
+void FrameCapture::convertToYuv(const Slot& slot, std::vector<uint8_t>& out) const {
+    // BT.601 full range, as the header's C420jpeg and XCOLORRANGE=FULL declare. Rows are
+    // flipped to top down; each chroma sample averages a 2x2 block, repeating edge pixels
+    const unsigned chromaWidth = (width + 1) / 2;
+    const unsigned chromaHeight = (height + 1) / 2;
+    uint8_t* yPlane = out.data();
+    uint8_t* uPlane = yPlane + static_cast<size_t>(width) * height;
+    uint8_t* vPlane = uPlane + static_cast<size_t>(chromaWidth) * chromaHeight;
+    auto pixel = [&slot, this](unsigned x, unsigned y) {
+        return &slot.pixels[(static_cast<size_t>(height - 1 - y) * width + x) * 4];
+    };
+
+    for (unsigned y = 0; y < height; ++y) {
+        const uint8_t* p = pixel(0, y);
+        uint8_t* row = yPlane + static_cast<size_t>(y) * width;
+        for (unsigned x = 0; x < width; ++x, p += 4) {
+            row[x] = static_cast<uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (unsigned cy = 0; cy < chromaHeight; ++cy) {
+        unsigned y0 = 2 * cy;
+        unsigned y1 = std::min(y0 + 1, height - 1);
+        for (unsigned cx = 0; cx < chromaWidth; ++cx) {
+            unsigned x0 = 2 * cx;
+            unsigned x1 = std::min(x0 + 1, width - 1);
+            const uint8_t* a = pixel(x0, y0);
+            const uint8_t* b = pixel(x1, y0);
+            const uint8_t* c = pixel(x0, y1);
+            const uint8_t* d = pixel(x1, y1);
+            int r = a[0] + b[0] + c[0] + d[0];
+            int g = a[1] + b[1] + c[1] + d[1];
+            int bl = a[2] + b[2] + c[2] + d[2];
+            size_t i = static_cast<size_t>(cy) * chromaWidth + cx;
+            uPlane[i] = clampByte((-43 * r - 85 * g + 128 * bl + (128 << 10) + 512) >> 10);
+            vPlane[i] = clampByte((128 * r - 107 * g - 21 * bl + (128 << 10) + 512) >> 10);
+        }
+    }
+}
+
+bool FrameCapture::writePng(const Slot& slot) const {
+    // sf::Image encodes without OpenGL, so this is safe off the render thread
+    char name[1024];
+    std::snprintf(name, sizeof(name), path.c_str(), static_cast<int>(slot.frame));
+    sf::Image image;
+    image.create(width, height, slot.pixels.data());
+    image.flipVertically();
+    return image.saveToFile(name);
+}
\ No newline at end of file
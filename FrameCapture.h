@@ -0,0 +1,84 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include "LatencyStats.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frames read back but not yet encoded; a frame finding its buffer still busy is dropped
+const size_t CAPTURE_BUFFERS = 6;
+const unsigned CAPTURE_WORKERS = 2;
+// Y4M streams are tagged with this rate; the offline capture renders exactly one frame per step
+const int CAPTURE_FPS = 60;
+
+// Writes rendered frames to a raw Y4M video (4:2:0, full range) or to a
+// numbered PNG sequence, encoding on worker threads. Frames are read from
+// an sf::RenderTexture straight into one of a fixed pool of pixel buffers,
+// then queued; the caller only waits for the readback itself. Buffers are
+// used round robin, so the output stays in order with any worker count.
+class FrameCapture {
+public:
+    FrameCapture(unsigned width, unsigned height, unsigned workerCount = CAPTURE_WORKERS);
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // path ending in .y4m: one video file. Ending in .png: a printf pattern for
+    // the frame number, such as frames/%05d.png, with one %d or %0Nd and no other
+    // %; anything else is refused. Starts the workers
+    bool open(const std::string& path);
+    // Reads target's pixels into the next buffer and queues them. If that buffer
+    // is still being encoded the frame is dropped, or with waitForBuffer, waited for
+    bool captureFrame(sf::RenderTexture& target, bool waitForBuffer);
+    // Encodes what is queued, stops the workers and prints how capture went
+    void finish();
+
+private:
+    enum class Format { Y4m, Png };
+    enum class SlotState { Free, Filled };
+
+    struct Slot {
+        // RGBA rows, bottom up as OpenGL reads them
+        std::vector<uint8_t> pixels;
+        // Planar YUV of the frame for Y4M
+        std::vector<uint8_t> encoded;
+        unsigned long frame = 0;
+        std::atomic<SlotState> state{SlotState::Free};
+    };
+
+    unsigned width;
+    unsigned height;
+    unsigned workerCount;
+    Format format = Format::Y4m;
+    std::string path;
+    std::ofstream video;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> workers;
+
+    // Render thread only
+    unsigned long framesQueued = 0;
+    unsigned long framesDropped = 0;
+    LatencyStats readback;
+
+    // Workers claim frames in order; Y4M frames are written once all earlier ones are
+    std::atomic<unsigned long> nextToEncode{0};
+    std::mutex mutex;
+    std::condition_variable changed;
+    unsigned long framesWritten = 0;
+    unsigned long writeErrors = 0;
+    bool stopping = false;
+
+    void workerLoop();
+    void convertToYuv(const Slot& slot, std::vector<uint8_t>& out) const;
+    bool writePng(const Slot& slot) const;
+};
+
+#endif // FRAMECAPTURE_H
\ No newline at end of file
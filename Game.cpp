@@ -1,177 +1,175 @@
 #include "Game.h"
-#include <cmath>
+#include "ResourceCache.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
-Game::Game()
+Game::Game(InputSource& input, uint32_t seed, unsigned ghostCount, bool vsync, FrameCapture* capture,
+           bool predictOnWorker)
     : window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "Bicycle on Wavy Terrain")
-    , view(sf::FloatRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT))
-    , world(b2Vec2(0.0f, 9.8f))
-    , bike(&world)
-    , terrain(&world)
-    , gameOverUI()
-    , isGameOver(false)
+    , input(input)
+    , simThread(input, seed, ghostCount)
+    , frame(ghostCount, predictOnWorker)
+    , capture(capture)
+#ifdef ENABLE_PROFILER
+    , profilerOverlay(ResourceCache::instance().getFont(DEFAULT_FONT))
+#endif
 {
     // Set up the main window
-    window.setVerticalSyncEnabled(false);
-    window.setFramerateLimit(60);
-    
-    // Initialize random number generator
-    std::random_device rd;
-    gen = std::mt19937(rd());
+    window.setVerticalSyncEnabled(vsync);
+    // Space is tracked from press and release events; repeats would only add noise
+    window.setKeyRepeatEnabled(false);
 
-    // --- Score system setup ---
-    if (!font.loadFromFile("DejaVuSans.ttf")) {
-        std::cerr << "Error: Could not load font DejaVuSans.ttf for score display" << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    score = 0;
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(48);
-    scoreText.setFillColor(sf::Color::White);
-    scoreText.setStyle(sf::Text::Bold);
-    scoreText.setString("0");
-    // Centered at top
-    sf::FloatRect textBounds = scoreText.getLocalBounds();
-    scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-    scoreText.setPosition(SCREEN_WIDTH / 2.0f, 40.0f);
+    if (capture) {
+        if (captureTarget.create(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+            captureSprite.setTexture(captureTarget.getTexture());
+        } else {
+            std::cerr << "Error: Could not create an offscreen target; not capturing" << std::endl;
+            this->capture = nullptr;
+        }
+    }
 }
 
 void Game::run() {
-    // Main game loop
+    // Main game loop: physics steps on its own thread, each frame draws the newest
+    // snapshot, interpolated by how far the clock has moved past its step
+    simThread.start();
+    sf::Clock frameClock;
+#ifdef TRACK_ALLOCATIONS
+    frameAllocations.begin();
+#endif
     while (window.isOpen()) {
         handleInput();
-        
-        if (!isGameOver) {
-            updatePhysics();
-            updateVisuals();
-            checkGameOver();
-        }
+        float frameTime = frameClock.restart().asSeconds();
+
+        const RenderSnapshot& snapshot = simThread.latest();
+        std::chrono::duration<float> sinceStep = std::chrono::steady_clock::now() - snapshot.steppedAt;
+        float alpha = std::min(std::max(sinceStep.count() / PHYSICS_TIMESTEP, 0.0f), 1.0f);
+        frame.update(snapshot, alpha, frameTime);
 
-        render();
+        render(snapshot, alpha);
+        PROFILE_FRAME_END();
+#ifdef TRACK_ALLOCATIONS
+        frameAllocations.endFrame();
+#endif
     }
+    // Join before the caller saves a recording the simulation thread writes to
+    simThread.stop();
+    if (pressToPresent.getCount() > 0) {
+        pressToPresent.print("Space press to present");
+    }
+    frame.finish();
+#ifdef TRACK_ALLOCATIONS
+    frameAllocations.print("Render frames");
+    simThread.getStepAllocations().print("Physics steps");
+#endif
 }
 
 void Game::handleInput() {
     // Handle window and UI events
+    PROFILE_SCOPE(HandleInput);
+    sf::Event event;
+    // Nothing moves while the game-over overlay is up, so sleep until something happens
+    if (frame.isGameOver() && !rewindHeld && window.waitEvent(event)) {
+        processEvent(event);
+    }
+    pollEvents();
+}
+
+void Game::pollEvents() {
+    // Drain the window's event queue; key events are timestamped as they come out
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-            gameOverUI.closeWindow();
-        }
+        processEvent(event);
+    }
+}
+
+void Game::processEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    if ((event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) &&
+        event.key.code == sf::Keyboard::Space) {
+        input.onSpaceEvent(event.type == sf::Event::KeyPressed, InputClock::now());
+    }
+    if ((event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) &&
+        event.key.code == sf::Keyboard::R) {
+        rewindHeld = event.type == sf::Event::KeyPressed;
+        simThread.setRewinding(rewindHeld);
+    }
+    // The release would go to another window, so let go of Space and R now
+    if (event.type == sf::Event::LostFocus) {
+        input.onSpaceEvent(false, InputClock::now());
+        rewindHeld = false;
+        simThread.setRewinding(false);
     }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
+        frame.toggleLandingOverlay();
+    }
+#ifdef ENABLE_PROFILER
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        profilerOverlay.toggle();
+    }
+#endif
 
     // Handle game over UI events
-    if (gameOverUI.isWindowOpen()) {
-        while (gameOverUI.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                gameOverUI.closeWindow();
-                isGameOver = false;
-                bike.reset();
-                score = 0;
-                scoreText.setString("0");
-                sf::FloatRect textBounds = scoreText.getLocalBounds();
-                scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-                scoreText.setPosition(SCREEN_WIDTH / 2.0f, 40.0f);
-            }
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                if (gameOverUI.isRestartClicked(event.mouseButton.x, event.mouseButton.y)) {
-                    gameOverUI.closeWindow();
-                    isGameOver = false;
-                    bike.reset();
-                    score = 0;
-                    scoreText.setString("0");
-                    sf::FloatRect textBounds = scoreText.getLocalBounds();
-                    scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-                    scoreText.setPosition(SCREEN_WIDTH / 2.0f, 40.0f);
-                }
+    if (frame.isGameOver()) {
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2f click = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y),
+                                                         window.getDefaultView());
+            if (frame.isRestartClicked(click.x, click.y)) {
+                restart();
             }
         }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter) {
+            restart();
+        }
     }
 }
 
-void Game::updatePhysics() {
-    // Update the physics world and bike
-    bool spacePressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
-    if (bike.updatePhysics(spacePressed)) {
-        score++;
-        scoreText.setString(std::to_string(score));
-        sf::FloatRect textBounds = scoreText.getLocalBounds();
-        scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-    }
-    world.Step(1.0f / 60.0f, 8, 3);
+void Game::restart() {
+    frame.restart();
+    simThread.restart();
 }
 
-void Game::updateVisuals() {
-    // Update visuals and camera view
-    b2Vec2 pos = bike.getPosition();
-    bike.updateVisuals();
-    terrain.extendIfNeeded(pos.x * SCALE, gen);
-    
-    // Smoothly follow the bike with the camera
-    sf::Vector2f target(pos.x * SCALE, 300.0f);
-    sf::Vector2f current = view.getCenter();
-    float smoothing = 0.1f;
-    view.setCenter(current + (target - current) * smoothing);
-}
-
-void Game::checkGameOver() {
-    // Check if the bike has hit the ground or fallen off the screen
-    b2Vec2 pos = bike.getPosition();
-    bool frameHitGround = false;
-
-    for (b2ContactEdge* edge = bike.getBody()->GetContactList(); edge; edge = edge->next) {
-        b2Contact* contact = edge->contact;
-        if (contact->IsTouching()) {
-            b2Fixture* bikeFixture = nullptr;
-            b2Fixture* groundFixture = nullptr;
-
-            if (contact->GetFixtureA()->GetBody() == bike.getBody()) {
-                bikeFixture = contact->GetFixtureA();
-                groundFixture = contact->GetFixtureB();
-            } else if (contact->GetFixtureB()->GetBody() == bike.getBody()) {
-                bikeFixture = contact->GetFixtureB();
-                groundFixture = contact->GetFixtureA();
-            }
-
-            if (bikeFixture && groundFixture && groundFixture->GetBody() == terrain.getBody()) {
-                uintptr_t userData = bikeFixture->GetUserData().pointer;
-                if (userData == 1) {
-                    // The bike frame hit the ground
-                    frameHitGround = true;
-                    std::cout << "Game Over: Bike frame hit ground" << std::endl;
-                    break;
-                } else if (userData == 2) {
-                    // Wheel hit ground (not game over)
-                }
+void Game::render(const RenderSnapshot& snapshot, float alpha) {
+    // Render the game scene and UI, offscreen first when capturing
+    {
+        PROFILE_SCOPE(Render);
+        sf::RenderTarget& target = capture ? static_cast<sf::RenderTarget&>(captureTarget) : window;
+        frame.draw(target, snapshot, alpha);
+        if (capture) {
+            captureTarget.display();
+            {
+                PROFILE_SCOPE(Capture);
+                capture->captureFrame(captureTarget, false);
             }
+            window.setView(window.getDefaultView());
+            window.draw(captureSprite);
         }
+#ifdef ENABLE_PROFILER
+        profilerOverlay.render(window);
+#endif
     }
-
-    if (pos.y * SCALE > SCREEN_HEIGHT || frameHitGround) {
-        if (pos.y * SCALE > SCREEN_HEIGHT) {
-            std::cout << "Game Over: Bike fell off screen (y = " << pos.y * SCALE << ")" << std::endl;
+    // Pump once more right before presenting, which may block on vsync, so a press made
+    // while this frame was drawn reaches the simulation now rather than next frame
+    {
+        PROFILE_SCOPE(HandleInput);
+        pollEvents();
+    }
+    {
+        PROFILE_SCOPE(Display);
+        window.display();
+    }
+    // The stamp is cleared while the simulation is not stepping, so only presses it applied count
+    if (snapshot.lastPressAt != lastPresentedPress) {
+        lastPresentedPress = snapshot.lastPressAt;
+        if (snapshot.lastPressAt != InputClock::time_point()) {
+            pressToPresent.record(InputClock::now() - snapshot.lastPressAt);
         }
-        isGameOver = true;
-        gameOverUI.openWindow();
-        score = 0;
-        scoreText.setString("0");
-        sf::FloatRect textBounds = scoreText.getLocalBounds();
-        scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-        scoreText.setPosition(SCREEN_WIDTH / 2.0f, 40.0f);
     }
-}
-
-void Game::render() {
-    // Render the game scene and UI
-    window.setView(view);
-    window.clear(sf::Color::Black);
-    terrain.render(window);
-    bike.render(window);
-    // Update scoreText position to follow the view
-    sf::Vector2f viewCenter = view.getCenter();
-    scoreText.setPosition(viewCenter.x, 40.0f + viewCenter.y - SCREEN_HEIGHT / 2.0f);
-    window.draw(scoreText);
-    window.display();
-    gameOverUI.render();
+    if (!firstFrameShown) {
+        firstFrameShown = true;
+        std::cout << "Startup to first frame: " << startupClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
 }
\ No newline at end of file
@@ -1,45 +1,68 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "Bicycle.h"
-#include "Terrain.h"
-#include "GameOverUI.h"
+#include "AllocationTracker.h"
+#include "FrameCapture.h"
+#include "GameFrame.h"
+#include "InputSource.h"
+#include "LatencyStats.h"
+#include "ProfilerOverlay.h"
+#include "SimulationThread.h"
 #include <SFML/Graphics.hpp>
-#include <box2d/box2d.h>
-#include <random>
 
-const int SCREEN_HEIGHT = 700;
-const int SCREEN_WIDTH = 1500;
+// Rendering is paced by vsync by default (--no-vsync runs it uncapped); physics keeps
+// its own fixed rate on SimulationThread
+const bool VSYNC_ENABLED = true;
 
 class Game {
 public:
-    Game();
+    // ghostCount scripted riders race alongside the player (see addScriptedGhosts).
+    // With an open capture, every frame is drawn offscreen, handed to it and then
+    // shown in the window; the caller finishes the capture after run().
+    // predictOnWorker moves landing prediction off the render thread
+    Game(InputSource& input, uint32_t seed, unsigned ghostCount = 0, bool vsync = VSYNC_ENABLED,
+         FrameCapture* capture = nullptr, bool predictOnWorker = false);
     void run();
 
 private:
+    // Started before anything else is constructed, read once the first frame is shown
+    sf::Clock startupClock;
+    bool firstFrameShown = false;
+
     // Core game components
     sf::RenderWindow window;
-    sf::View view;
-    b2World world;
-    std::mt19937 gen;
-    bool isGameOver;
+    InputSource& input;
+    // R is held: the simulation plays its history backwards
+    bool rewindHeld = false;
 
     // Game objects
-    Bicycle bike;
-    Terrain terrain;
-    GameOverUI gameOverUI;
+    SimulationThread simThread;
+    // Game over, score, landing prediction, camera and drawing of each frame
+    GameFrame frame;
+
+    // Offscreen frame capture, if any: frames are drawn to captureTarget, then
+    // blitted to the window through captureSprite
+    FrameCapture* capture;
+    sf::RenderTexture captureTarget;
+    sf::Sprite captureSprite;
+
+    // From a Space press being pumped to the first presented frame that includes it
+    LatencyStats pressToPresent;
+    InputClock::time_point lastPresentedPress;
 
-    // Score system
-    int score = 0;
-    sf::Font font;
-    sf::Text scoreText;
+#ifdef ENABLE_PROFILER
+    ProfilerOverlay profilerOverlay;
+#endif
+#ifdef TRACK_ALLOCATIONS
+    AllocationMeter frameAllocations;
+#endif
 
     // Helper functions
     void handleInput();
-    void updatePhysics();
-    void updateVisuals();
-    void checkGameOver();
-    void render();
+    void pollEvents();
+    void processEvent(const sf::Event& event);
+    void restart();
+    void render(const RenderSnapshot& snapshot, float alpha);
 };
 
 #endif // GAME_H
\ No newline at end of file
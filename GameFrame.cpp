@@ -0,0 +1,91 @@
+#include "GameFrame.h"
+#include "Profiler.h"
+#include <iostream>
+
+GameFrame::GameFrame(unsigned ghostCount, bool predictOnWorker)
+    : scene(ghostCount + 1)
+    , gameOverUI(SCREEN_WIDTH, SCREEN_HEIGHT)
+    , predictor(predictOnWorker)
+{
+}
+
+void GameFrame::update(const RenderSnapshot& snapshot, float alpha, float frameTime) {
+    checkGameOver(snapshot);
+    updateScore(snapshot);
+    updatePrediction(snapshot);
+    if (!gameOver) {
+        updateVisuals(snapshot, alpha, frameTime);
+    }
+}
+
+void GameFrame::draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha) {
+    scene.render(target, snapshot, alpha);
+    if (!gameOver) {
+        landingOverlay.render(target, predictor.latest(), scene.getViewOriginChunk());
+    }
+    gameOverUI.render(target);
+}
+
+void GameFrame::restart() {
+    gameOverUI.hide();
+    gameOver = false;
+    scene.setScore(0);
+}
+
+void GameFrame::finish() {
+    predictor.stop();
+    predictor.printStats("Landing prediction");
+    if (predictionAccuracy.getOutcomeCount() > 0) {
+        predictionAccuracy.print("Landing prediction accuracy");
+    }
+}
+
+void GameFrame::updateScore(const RenderSnapshot& snapshot) {
+    // Follow the simulation's score; the snapshot still holds the old run's until the restart lands
+    if (gameOver || snapshot.run == crashedRun || snapshot.score == scene.getScore()) {
+        return;
+    }
+    scene.setScore(snapshot.score);
+}
+
+void GameFrame::updateVisuals(const RenderSnapshot& snapshot, float alpha, float frameTime) {
+    // Smoothly follow the bike with the camera
+    PROFILE_SCOPE(UpdateVisuals);
+    scene.updateCamera(snapshot, alpha, frameTime);
+}
+
+void GameFrame::checkGameOver(const RenderSnapshot& snapshot) {
+    // Show the overlay the first time a snapshot reports this run's crash
+    if (gameOver && snapshot.run != crashedRun) {
+        // Rewinding took the bike back before the crash
+        gameOverUI.hide();
+        gameOver = false;
+    }
+    if (snapshot.crash == CrashReason::None || snapshot.run == crashedRun) {
+        return;
+    }
+    crashedRun = snapshot.run;
+    if (snapshot.crash == CrashReason::FellOffScreen) {
+        std::cout << "Game Over: Bike fell off screen (y = " << snapshot.player.current.y << ")" << std::endl;
+    } else {
+        std::cout << "Game Over: " << crashReasonName(snapshot.crash) << std::endl;
+    }
+    gameOver = true;
+    gameOverUI.show(snapshot.score);
+    scene.setScore(0);
+}
+
+void GameFrame::updatePrediction(const RenderSnapshot& snapshot) {
+    // Predict from each new physics step, and between steps spend the frame's budget
+    // on a path still unfinished; a crashed run has nothing left to predict
+    PROFILE_SCOPE(Predict);
+    if (snapshot.crash == CrashReason::None) {
+        if (snapshot.step != predictedStep) {
+            predictedStep = snapshot.step;
+            predictor.submit(snapshot);
+        } else {
+            predictor.advance();
+        }
+    }
+    predictionAccuracy.observe(snapshot, predictor.latest());
+}
@@ -0,0 +1,51 @@
+#ifndef GAMEFRAME_H
+#define GAMEFRAME_H
+
+#include "GameOverUI.h"
+#include "LandingOverlay.h"
+#include "LandingPredictor.h"
+#include "SceneRenderer.h"
+#include "SimulationThread.h"
+#include <SFML/Graphics.hpp>
+
+// What Game does with each frame's snapshot, apart from the window: report a
+// crash, follow the score, predict the landing, move the camera, then draw
+// the scene and its overlays into a target. Game runs it every frame; the
+// bench runs the same code offscreen to check that frames don't allocate.
+class GameFrame {
+public:
+    // predictOnWorker moves landing prediction off the calling thread
+    GameFrame(unsigned ghostCount, bool predictOnWorker = false);
+    // Once per frame with the newest snapshot, before draw()
+    void update(const RenderSnapshot& snapshot, float alpha, float frameTime);
+    // Scene, landing prediction and game-over overlay
+    void draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha);
+    // Hides the game-over overlay; the caller restarts the simulation
+    void restart();
+    bool isGameOver() const { return gameOver; }
+    bool isRestartClicked(float x, float y) const { return gameOverUI.isRestartClicked(x, y); }
+    void toggleLandingOverlay() { landingOverlay.toggle(); }
+    // Joins the prediction worker and prints prediction cost and accuracy
+    void finish();
+
+private:
+    bool gameOver = false;
+    // Run whose crash was last reported, so each crash shows the overlay once
+    unsigned crashedRun = ~0u;
+
+    SceneRenderer scene;
+    GameOverUI gameOverUI;
+
+    // Where the player will land, predicted once per physics step and scored against what happens
+    LandingPredictor predictor;
+    LandingOverlay landingOverlay;
+    PredictionAccuracy predictionAccuracy;
+    unsigned long predictedStep = ~0ul;
+
+    void checkGameOver(const RenderSnapshot& snapshot);
+    void updateScore(const RenderSnapshot& snapshot);
+    void updatePrediction(const RenderSnapshot& snapshot);
+    void updateVisuals(const RenderSnapshot& snapshot, float alpha, float frameTime);
+};
+
+#endif // GAMEFRAME_H
@@ -1,14 +1,22 @@
 #include "GameOverUI.h"
-#include <iostream>
+#include "ResourceCache.h"
+#include <string>
 
-GameOverUI::GameOverUI() {
-    // Attempt to load the font for UI text
-    if (!font.loadFromFile("DejaVuSans.ttf")) {
-        // Fallback font loading or error handling
-        // For now, print an error and exit
-        std::cerr << "Error: Could not load font DejaVuSans.ttf" << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
+GameOverUI::GameOverUI(float screenWidth, float screenHeight) {
+    // Shares the font the score display already loaded
+    const sf::Font& font = ResourceCache::instance().getFont(DEFAULT_FONT);
+
+    // The panel keeps the old 400x300 layout, centered on the screen
+    sf::Vector2f origin((screenWidth - 400.0f) / 2.0f, (screenHeight - 300.0f) / 2.0f);
+
+    dimmer.setSize(sf::Vector2f(screenWidth, screenHeight));
+    dimmer.setFillColor(sf::Color(0, 0, 0, 120));
+
+    panel.setSize(sf::Vector2f(400.0f, 300.0f));
+    panel.setPosition(origin);
+    panel.setFillColor(sf::Color::Black);
+    panel.setOutlineThickness(2.0f);
+    panel.setOutlineColor(sf::Color::White);
 
     gameOverText.setFont(font);
     gameOverText.setString("Game Over!");
@@ -17,10 +25,17 @@ GameOverUI::GameOverUI() {
     gameOverText.setStyle(sf::Text::Bold);
     sf::FloatRect textBounds = gameOverText.getLocalBounds();
     gameOverText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
-    gameOverText.setPosition(200.0f, 100.0f);
+    gameOverText.setPosition(origin.x + 200.0f, origin.y + 70.0f);
+
+    // The string is set on show(), once per crash
+    scoreText.setFont(font);
+    scoreText.setCharacterSize(22);
+    scoreText.setFillColor(sf::Color::White);
+    centerX = origin.x + 200.0f;
+    scoreY = origin.y + 115.0f;
 
     restartButton.setSize(sf::Vector2f(150.0f, 50.0f));
-    restartButton.setPosition(125.0f, 150.0f);
+    restartButton.setPosition(origin.x + 125.0f, origin.y + 150.0f);
     restartButton.setFillColor(sf::Color::Blue);
     restartButton.setOutlineThickness(2.0f);
     restartButton.setOutlineColor(sf::Color::White);
@@ -31,39 +46,51 @@ GameOverUI::GameOverUI() {
     restartText.setFillColor(sf::Color::White);
     sf::FloatRect restartTextBounds = restartText.getLocalBounds();
     restartText.setOrigin(restartTextBounds.width / 2.0f, restartTextBounds.height / 2.0f);
-    restartText.setPosition(200.0f, 175.0f);
-}
+    restartText.setPosition(origin.x + 200.0f, origin.y + 175.0f);
 
-void GameOverUI::openWindow() {
-    gameOverWindow.create(sf::VideoMode(400, 300), "Game Over");
-    gameOverWindow.setFramerateLimit(60);
+    rewindText.setFont(font);
+    rewindText.setString("Hold R to rewind");
+    rewindText.setCharacterSize(16);
+    rewindText.setFillColor(sf::Color(170, 170, 170));
+    sf::FloatRect rewindTextBounds = rewindText.getLocalBounds();
+    rewindText.setOrigin(rewindTextBounds.width / 2.0f, rewindTextBounds.height / 2.0f);
+    rewindText.setPosition(origin.x + 200.0f, origin.y + 240.0f);
 }
 
-void GameOverUI::closeWindow() {
-    if (gameOverWindow.isOpen()) {
-        gameOverWindow.close();
-    }
+void GameOverUI::show(int score) {
+    scoreText.setString("Score: " + std::to_string(score));
+    sf::FloatRect scoreBounds = scoreText.getLocalBounds();
+    scoreText.setOrigin(scoreBounds.width / 2.0f, scoreBounds.height / 2.0f);
+    scoreText.setPosition(centerX, scoreY);
+    visible = true;
 }
 
-bool GameOverUI::isWindowOpen() const {
-    return gameOverWindow.isOpen();
+void GameOverUI::hide() {
+    visible = false;
 }
 
-bool GameOverUI::pollEvent(sf::Event& event) {
-    return gameOverWindow.pollEvent(event);
+bool GameOverUI::isVisible() const {
+    return visible;
 }
 
-bool GameOverUI::isRestartClicked(float mouseX, float mouseY) {
+bool GameOverUI::isRestartClicked(float mouseX, float mouseY) const {
     sf::FloatRect buttonBounds = restartButton.getGlobalBounds();
-    return buttonBounds.contains(mouseX, mouseY);
+    return visible && buttonBounds.contains(mouseX, mouseY);
 }
 
-void GameOverUI::render() {
-    if (gameOverWindow.isOpen()) {
-        gameOverWindow.clear(sf::Color::Black);
-        gameOverWindow.draw(gameOverText);
-        gameOverWindow.draw(restartButton);
-        gameOverWindow.draw(restartText);
-        gameOverWindow.display();
+void GameOverUI::render(sf::RenderTarget& target) {
+    if (!visible) {
+        return;
     }
+    // Draw in screen space, then restore the game camera
+    sf::View previous = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(dimmer);
+    target.draw(panel);
+    target.draw(gameOverText);
+    target.draw(scoreText);
+    target.draw(restartButton);
+    target.draw(restartText);
+    target.draw(rewindText);
+    target.setView(previous);
 }
\ No newline at end of file
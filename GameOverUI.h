@@ -3,22 +3,28 @@
 
 #include <SFML/Graphics.hpp>
 
+// Game-over panel drawn over the main window, in screen coordinates
 class GameOverUI {
 public:
-    GameOverUI();
-    void openWindow();
-    void closeWindow();
-    bool isWindowOpen() const;
-    bool pollEvent(sf::Event& event);
-    bool isRestartClicked(float mouseX, float mouseY);
-    void render();
+    GameOverUI(float screenWidth, float screenHeight);
+    // Shows the panel with the score the run ended on
+    void show(int score);
+    void hide();
+    bool isVisible() const;
+    bool isRestartClicked(float mouseX, float mouseY) const;
+    void render(sf::RenderTarget& target);
 
 private:
-    sf::RenderWindow gameOverWindow;
-    sf::Font font;
+    bool visible = false;
+    sf::RectangleShape dimmer;
+    sf::RectangleShape panel;
     sf::Text gameOverText;
+    sf::Text scoreText;
+    float centerX = 0.0f;
+    float scoreY = 0.0f;
     sf::RectangleShape restartButton;
     sf::Text restartText;
+    sf::Text rewindText;
 };
 
 #endif // GAMEOVERUI_H
\ No newline at end of file
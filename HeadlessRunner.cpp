@@ -0,0 +1,42 @@
+#include "HeadlessRunner.h"
+#include <chrono>
+#include <iostream>
+
+HeadlessRunner::HeadlessRunner(InputSource& input, unsigned long maxSteps, uint32_t seed,
+                               const BikeParams& params)
+    : input(input)
+    , maxSteps(maxSteps)
+    , sim(seed, params)
+{
+}
+
+HeadlessStats HeadlessRunner::run() {
+    HeadlessStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    while (sim.getStepCount() < maxSteps) {
+        sim.step(input.isSpacePressed(sim.getStepCount()));
+        stats.crash = sim.checkCrash();
+        if (stats.crash != CrashReason::None) {
+            break;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.steps = sim.getStepCount();
+    stats.seconds = elapsed.count();
+    stats.stepsPerSecond = stats.seconds > 0.0 ? stats.steps / stats.seconds : 0.0;
+    stats.distance = sim.getDistance();
+    stats.score = sim.getScore();
+    return stats;
+}
+
+void printHeadlessStats(const HeadlessStats& stats) {
+    std::cout << "Steps:       " << stats.steps << "\n"
+              << "Wall time:   " << stats.seconds << " s\n"
+              << "Steps/sec:   " << stats.stepsPerSecond << "\n"
+              << "Sim time:    " << stats.steps * PHYSICS_TIMESTEP << " s\n"
+              << "Distance:    " << stats.distance << " m\n"
+              << "Score:       " << stats.score << "\n"
+              << "Crash:       " << crashReasonName(stats.crash) << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include "InputSource.h"
+#include "Simulation.h"
+
+struct HeadlessStats {
+    unsigned long steps = 0;
+    double seconds = 0.0;
+    double stepsPerSecond = 0.0;
+    float distance = 0.0f;
+    int score = 0;
+    CrashReason crash = CrashReason::None;
+};
+
+// Steps a Simulation as fast as the CPU allows, with no window or font
+class HeadlessRunner {
+public:
+    HeadlessRunner(InputSource& input, unsigned long maxSteps, uint32_t seed,
+                   const BikeParams& params = BikeParams());
+    // Runs until the bike crashes or maxSteps is reached
+    HeadlessStats run();
+
+private:
+    InputSource& input;
+    unsigned long maxSteps;
+    Simulation sim;
+};
+
+void printHeadlessStats(const HeadlessStats& stats);
+
+#endif // HEADLESSRUNNER_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "Heightfield.h"
+#include "Bicycle.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+Heightfield::Heightfield(float startX, float step, const float* heights, size_t count)
+    : startX(startX)
+    , step(step)
+    , samples(count)
+{
+#ifdef QUANTIZE_TERRAIN
+    // Quantize relative to the first sample, so it (the seam with the previous chunk) stays exact
+    baseY = heights[0];
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<HeightSample>(std::lround((heights[i] - baseY) / HEIGHT_QUANTUM));
+    }
+#else
+    std::copy(heights, heights + count, samples.begin());
+#endif
+}
+
+float Heightfield::sampleY(size_t i) const {
+#ifdef QUANTIZE_TERRAIN
+    return baseY + samples[i] * HEIGHT_QUANTUM;
+#else
+    return samples[i];
+#endif
+}
+
+b2Vec2 Heightfield::vertex(size_t i) const {
+    return b2Vec2(sampleX(i) / SCALE, sampleY(i) / SCALE);
+}
+
+size_t Heightfield::segmentAt(float x, float& fraction) const {
+    float position = std::min(std::max((x - startX) / step, 0.0f), static_cast<float>(samples.size() - 1));
+    size_t i = std::min(static_cast<size_t>(position), samples.size() - 2);
+    fraction = position - i;
+    return i;
+}
+
+float Heightfield::heightAt(float x) const {
+    float fraction;
+    size_t i = segmentAt(x, fraction);
+    return sampleY(i) + (sampleY(i + 1) - sampleY(i)) * fraction;
+}
+
+float Heightfield::slopeAt(float x) const {
+    float fraction;
+    size_t i = segmentAt(x, fraction);
+    return (sampleY(i + 1) - sampleY(i)) / step;
+}
+
+void Heightfield::selectVertices(float tolerance, std::vector<uint16_t>& out) const {
+    size_t n = samples.size();
+    out.clear();
+    if (n <= 4) {
+        for (size_t i = 0; i < n; ++i) {
+            out.push_back(static_cast<uint16_t>(i));
+        }
+        return;
+    }
+
+    // Spans still to check, as (first, last) sample indices; the stack keeps them in x order
+    std::vector<std::pair<size_t, size_t>> spans;
+    spans.emplace_back(1, n - 2);
+    out.push_back(0);
+    out.push_back(1);
+    while (!spans.empty()) {
+        size_t first = spans.back().first;
+        size_t last = spans.back().second;
+        spans.pop_back();
+
+        float y0 = sampleY(first);
+        float dy = (sampleY(last) - y0) / (last - first);
+        size_t worst = first;
+        float worstError = tolerance;
+        for (size_t i = first + 1; i < last; ++i) {
+            float error = std::abs(sampleY(i) - (y0 + dy * (i - first)));
+            if (error > worstError) {
+                worst = i;
+                worstError = error;
+            }
+        }
+        if (worst == first) {
+            out.push_back(static_cast<uint16_t>(last));
+        } else {
+            // Right half goes below the left one so the left is finished first
+            spans.emplace_back(worst, last);
+            spans.emplace_back(first, worst);
+        }
+    }
+    out.push_back(static_cast<uint16_t>(n - 1));
+}
+
+float Heightfield::maxDeviation(const std::vector<uint16_t>& picked) const {
+    float worst = 0.0f;
+    for (size_t k = 0; k + 1 < picked.size(); ++k) {
+        size_t first = picked[k];
+        size_t last = picked[k + 1];
+        float y0 = sampleY(first);
+        float dy = (sampleY(last) - y0) / (last - first);
+        for (size_t i = first + 1; i < last; ++i) {
+            worst = std::max(worst, std::abs(sampleY(i) - (y0 + dy * (i - first))));
+        }
+    }
+    return worst;
+}
\ No newline at end of file
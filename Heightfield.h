@@ -0,0 +1,61 @@
+#ifndef HEIGHTFIELD_H
+#define HEIGHTFIELD_H
+
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Build with -DQUANTIZE_TERRAIN to store heights as 16-bit steps of
+// HEIGHT_QUANTUM pixels around the first sample instead of floats
+const float HEIGHT_QUANTUM = 1.0f / 8.0f;
+#ifdef QUANTIZE_TERRAIN
+typedef int16_t HeightSample;
+#else
+typedef float HeightSample;
+#endif
+
+// Ground heights sampled at a fixed spacing: sample i lies at x = startX + i * step.
+// Only the heights are stored; Box2D vertices and render geometry are derived from them.
+// All coordinates are in pixels unless noted.
+class Heightfield {
+public:
+    Heightfield() = default;
+    // Needs at least two samples
+    Heightfield(float startX, float step, const float* heights, size_t count);
+
+    size_t size() const { return samples.size(); }
+    float getStartX() const { return startX; }
+    float getStep() const { return step; }
+    float getEndX() const { return startX + (samples.size() - 1) * step; }
+    float sampleX(size_t i) const { return startX + i * step; }
+    float sampleY(size_t i) const;
+    // Sample i in Box2D units
+    b2Vec2 vertex(size_t i) const;
+
+    // Ground height at x, linearly interpolated; x outside the field is clamped to its ends
+    float heightAt(float x) const;
+    // dy/dx of the segment under x; positive where the ground falls away to the right
+    float slopeAt(float x) const;
+
+    // Picks the samples to use as vertices: a span is split at its worst sample
+    // (Douglas-Peucker) until straight lines between picked samples stay within
+    // tolerance pixels of every sample, so flat ground gets few vertices and
+    // tight curves many. The first two and last two samples are always picked.
+    void selectVertices(float tolerance, std::vector<uint16_t>& out) const;
+    // Largest vertical distance between the samples and straight lines through the picked ones
+    float maxDeviation(const std::vector<uint16_t>& picked) const;
+
+private:
+    float startX = 0.0f;
+    float step = 1.0f;
+#ifdef QUANTIZE_TERRAIN
+    float baseY = 0.0f;
+#endif
+    std::vector<HeightSample> samples;
+
+    // Index of the segment [i, i + 1] containing x, and x's position within it in [0, 1]
+    size_t segmentAt(float x, float& fraction) const;
+};
+
+#endif // HEIGHTFIELD_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "InputSource.h"
+#include <utility>
+
+bool KeyboardInput::isSpacePressed(unsigned long step) {
+    (void)step;
+    return spaceDown;
+}
+
+void KeyboardInput::onSpaceEvent(bool pressed, InputClock::time_point at) {
+    // Once the queue has overflowed, merge into the overflow state until it has been taken in
+    unsigned current = overflow.load(std::memory_order_acquire);
+    while (current != 0) {
+        unsigned merged = OVERFLOWED | (pressed ? OVERFLOW_HELD | OVERFLOW_TAPPED : current & OVERFLOW_TAPPED);
+        if (overflow.compare_exchange_weak(current, merged, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+    KeyEvent event{pressed, at};
+    if (!events.tryPush(event)) {
+        // Only this thread sets overflow, and the simulation thread only clears it
+        overflow.store(OVERFLOWED | (pressed ? OVERFLOW_HELD | OVERFLOW_TAPPED : 0), std::memory_order_release);
+    }
+}
+
+void KeyboardInput::advanceTo(InputClock::time_point deadline) {
+    // Apply events in order until one belongs to a later step; a press seen here holds
+    // Space down for this step even if its release came in too
+    bool tapped = false;
+    while (hasPending || events.tryPop(pending)) {
+        hasPending = true;
+        if (pending.at > deadline) {
+            break;
+        }
+        hasPending = false;
+        held = pending.pressed;
+        if (pending.pressed) {
+            tapped = true;
+            lastPress = pending.at;
+        }
+    }
+    // The queue is empty, so the merged overflow state is the newest input. Its
+    // presses carry no stamps, so they are left out of the latency stats
+    if (!hasPending) {
+        unsigned merged = overflow.exchange(0, std::memory_order_acq_rel);
+        if (merged != 0) {
+            held = (merged & OVERFLOW_HELD) != 0;
+            tapped = tapped || (merged & OVERFLOW_TAPPED) != 0;
+        }
+    }
+    spaceDown = held || tapped;
+}
+
+void KeyboardInput::discardUntil(InputClock::time_point now) {
+    while (hasPending || events.tryPop(pending)) {
+        hasPending = true;
+        if (pending.at > now) {
+            break;
+        }
+        hasPending = false;
+        held = pending.pressed;
+    }
+    if (!hasPending) {
+        unsigned merged = overflow.exchange(0, std::memory_order_acq_rel);
+        if (merged != 0) {
+            held = (merged & OVERFLOW_HELD) != 0;
+        }
+    }
+    spaceDown = held;
+    lastPress = InputClock::time_point();
+}
+
+ScriptedInput::ScriptedInput(unsigned long holdSteps, unsigned long releaseSteps)
+    : holdSteps(holdSteps)
+    , releaseSteps(releaseSteps)
+{
+}
+
+bool ScriptedInput::isSpacePressed(unsigned long step) {
+    unsigned long period = holdSteps + releaseSteps;
+    if (period == 0) {
+        return false;
+    }
+    return step % period < holdSteps;
+}
+
+CallbackInput::CallbackInput(std::function<bool(unsigned long)> callback)
+    : callback(std::move(callback))
+{
+}
+
+bool CallbackInput::isSpacePressed(unsigned long step) {
+    return callback(step);
+}
\ No newline at end of file
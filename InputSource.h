@@ -0,0 +1,90 @@
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+typedef std::chrono::steady_clock InputClock;
+
+// Supplies the Space state for each physics step. isSpacePressed and
+// advanceTo are called from whichever thread steps the simulation;
+// onSpaceEvent from the window thread.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+    virtual bool isSpacePressed(unsigned long step) = 0;
+    // A Space press or release from the window, stamped when it was pumped
+    virtual void onSpaceEvent(bool pressed, InputClock::time_point at) { (void)pressed; (void)at; }
+    // Before each step: take in the events stamped up to deadline
+    virtual void advanceTo(InputClock::time_point deadline) { (void)deadline; }
+    // While the simulation is not stepping (crashed, rewinding, restarting): drop the
+    // events stamped up to now so they cannot fire on a later step, keeping only
+    // whether Space is held, and clear the last press stamp
+    virtual void discardUntil(InputClock::time_point now) { (void)now; }
+    // Stamp of the newest press taken in so far, for latency stats; the epoch if none
+    virtual InputClock::time_point getLastPressTime() const { return InputClock::time_point(); }
+};
+
+// Space from timestamped window events, handed to the simulation thread
+// through a lock-free queue. Each step applies the events stamped up to its
+// deadline, so input lands on the step nearest to when it happened rather
+// than whenever a frame last looked at the keyboard. A press and release
+// between two steps still counts as pressed for one step. If the queue
+// fills up, further events are merged into one overflow state that is
+// applied once the queue has drained, so a release is never lost.
+class KeyboardInput : public InputSource {
+public:
+    bool isSpacePressed(unsigned long step) override;
+    void onSpaceEvent(bool pressed, InputClock::time_point at) override;
+    void advanceTo(InputClock::time_point deadline) override;
+    void discardUntil(InputClock::time_point now) override;
+    InputClock::time_point getLastPressTime() const override { return lastPress; }
+
+private:
+    struct KeyEvent {
+        bool pressed;
+        InputClock::time_point at;
+    };
+
+    // Bits of overflow: set while events are being merged instead of queued,
+    // whether the newest of them was a press, and whether any of them was
+    static const unsigned OVERFLOWED = 1;
+    static const unsigned OVERFLOW_HELD = 2;
+    static const unsigned OVERFLOW_TAPPED = 4;
+
+    SpscQueue<KeyEvent, 64> events;
+    // Written by the window thread only while set, cleared by the simulation thread
+    // once the queue is empty, so merged events stay behind the queued ones
+    std::atomic<unsigned> overflow{0};
+    // Simulation thread only: an event popped early, waiting for its step
+    KeyEvent pending{};
+    bool hasPending = false;
+    bool held = false;
+    bool spaceDown = false;
+    InputClock::time_point lastPress;
+};
+
+// Holds Space for holdSteps, then releases it for releaseSteps, repeating
+class ScriptedInput : public InputSource {
+public:
+    ScriptedInput(unsigned long holdSteps, unsigned long releaseSteps);
+    bool isSpacePressed(unsigned long step) override;
+
+private:
+    unsigned long holdSteps;
+    unsigned long releaseSteps;
+};
+
+// Asks a callback, for drivers that decide programmatically
+class CallbackInput : public InputSource {
+public:
+    CallbackInput(std::function<bool(unsigned long)> callback);
+    bool isSpacePressed(unsigned long step) override;
+
+private:
+    std::function<bool(unsigned long)> callback;
+};
+
+#endif // INPUTSOURCE_H
\ No newline at end of file
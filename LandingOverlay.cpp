@@ -0,0 +1,48 @@
+#include "LandingOverlay.h"
+#include <cmath>
+
+namespace {
+const sf::Color LANDING_COLOR(80, 220, 80, 200);
+const sf::Color CRASH_COLOR(230, 60, 60, 220);
+// Half the touchdown bar, about half a bike
+const float MARKER_HALF_LENGTH = 30.0f;
+const float MARKER_TICK = 8.0f;
+}
+
+LandingOverlay::LandingOverlay() {
+    path.resize(2 * PREDICTION_HORIZON_STEPS);
+    path.clear();
+    marker.resize(4);
+    marker.clear();
+}
+
+void LandingOverlay::render(sf::RenderTarget& target, const LandingPrediction& prediction, int originChunk) {
+    // Nothing to show while the bike stays on the ground for the whole horizon
+    if (!visible || prediction.outcome == LandingOutcome::None || prediction.pathLength == 0) {
+        return;
+    }
+    sf::Color color = prediction.outcome == LandingOutcome::Crashes ? CRASH_COLOR : LANDING_COLOR;
+    // The prediction may predate an origin shift
+    float offsetX = (prediction.originChunk - originChunk) * SEGMENT_LENGTH;
+
+    // Every other segment between path points, which reads as a dashed line
+    path.clear();
+    for (size_t i = 0; i + 1 < prediction.pathLength; i += 2) {
+        const RiderPose& a = prediction.path[i];
+        const RiderPose& b = prediction.path[i + 1];
+        path.append(sf::Vertex(sf::Vector2f(a.x + offsetX, a.y), color));
+        path.append(sf::Vertex(sf::Vector2f(b.x + offsetX, b.y), color));
+    }
+
+    const RiderPose& touchdown = prediction.touchdown;
+    sf::Vector2f center(touchdown.x + offsetX, touchdown.y);
+    sf::Vector2f along(std::cos(touchdown.angle) * MARKER_HALF_LENGTH, std::sin(touchdown.angle) * MARKER_HALF_LENGTH);
+    marker.clear();
+    marker.append(sf::Vertex(center - along, color));
+    marker.append(sf::Vertex(center + along, color));
+    marker.append(sf::Vertex(center, color));
+    marker.append(sf::Vertex(center + sf::Vector2f(0.0f, MARKER_TICK), color));
+
+    target.draw(path);
+    target.draw(marker);
+}
\ No newline at end of file
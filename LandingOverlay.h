@@ -0,0 +1,24 @@
+#ifndef LANDINGOVERLAY_H
+#define LANDINGOVERLAY_H
+
+#include "LandingPredictor.h"
+#include <SFML/Graphics.hpp>
+
+// Draws a LandingPrediction in the world: the path as a dashed line and a
+// bar at the touchdown along the bike's predicted angle, green for a
+// landing and red for a crash. Toggled with P.
+class LandingOverlay {
+public:
+    LandingOverlay();
+    void toggle() { visible = !visible; }
+    // Draws through target's current view; originChunk is the one that view is relative to
+    void render(sf::RenderTarget& target, const LandingPrediction& prediction, int originChunk);
+
+private:
+    bool visible = true;
+    // Both rebuilt every frame into storage kept from the last one
+    sf::VertexArray path{sf::Lines};
+    sf::VertexArray marker{sf::Lines};
+};
+
+#endif // LANDINGOVERLAY_H
\ No newline at end of file
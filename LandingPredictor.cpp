@@ -0,0 +1,336 @@
+#include "LandingPredictor.h"
+#include "ContactListener.h"
+#include "Terrain.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+// How far the real bike may be from the predicted path and still follow it. Airborne,
+// both worlds integrate the same body the same way, so the match is exact in practice
+const float PATH_POSITION_TOLERANCE = 0.01f;
+const float PATH_ANGLE_TOLERANCE = 0.01f;
+const float PATH_VELOCITY_TOLERANCE = 0.05f;
+// The worker's nap when it has nothing new to predict from
+const std::chrono::milliseconds WORKER_IDLE(1);
+
+RiderPose poseOf(const BikeState& state) {
+    return RiderPose{state.position.x * SCALE, state.position.y * SCALE, state.angle};
+}
+
+bool follows(const BikeState& predicted, const BikeState& actual) {
+    return (predicted.position - actual.position).Length() < PATH_POSITION_TOLERANCE &&
+           std::abs(predicted.angle - actual.angle) < PATH_ANGLE_TOLERANCE &&
+           (predicted.linearVelocity - actual.linearVelocity).Length() < PATH_VELOCITY_TOLERANCE &&
+           std::abs(predicted.angularVelocity - actual.angularVelocity) < PATH_VELOCITY_TOLERANCE;
+}
+}
+
+LandingPredictor::LandingPredictor(bool useWorker, const BikeParams& params)
+    : world(b2Vec2(0.0f, GRAVITY))
+    , bike(&world, params)
+    , useWorker(useWorker)
+{
+    ground.reserve(PREDICTION_CHUNKS_AHEAD + 2);
+    chainVertices.reserve(CHUNK_SAMPLES);
+    if (useWorker) {
+        running = true;
+        worker = std::thread(&LandingPredictor::workerLoop, this);
+    }
+}
+
+LandingPredictor::~LandingPredictor() {
+    stop();
+}
+
+void LandingPredictor::stop() {
+    if (worker.joinable()) {
+        running = false;
+        worker.join();
+    }
+}
+
+void LandingPredictor::submit(const RenderSnapshot& snapshot) {
+    // Copy what the prediction needs; the chunk list reuses the slot's storage
+    Input& input = useWorker ? inputs.back() : syncInput;
+    input.step = snapshot.step;
+    input.bike = snapshot.playerState;
+    input.spacePressed = snapshot.spacePressed;
+    input.wheelOnGround = snapshot.wheelOnGround;
+    input.chunks = snapshot.chunks;
+    input.originChunk = snapshot.originChunk;
+    if (useWorker) {
+        inputs.publish();
+    } else {
+        predict(syncInput);
+    }
+}
+
+const LandingPrediction& LandingPredictor::latest() {
+    results.update();
+    return results.front();
+}
+
+bool LandingPredictor::isFinished() const {
+    return hasPath &&
+           (outcome != LandingOutcome::None || leftGround || lastStep - firstStep >= PREDICTION_HORIZON_STEPS);
+}
+
+void LandingPredictor::advance() {
+    if (useWorker || !hasPath || isFinished()) {
+        return;
+    }
+    extend(std::chrono::steady_clock::now());
+}
+
+void LandingPredictor::predict(const Input& input) {
+    // Keep the path if the real bike is still on it, else start over from the real state;
+    // then extend it until it ends or the budget runs out
+    auto start = std::chrono::steady_clock::now();
+    syncGround(input);
+    predictions++;
+    const BikeState& predicted = trajectory[input.step % trajectory.size()];
+    if (hasPath && input.step >= firstStep && input.step <= lastStep && input.spacePressed == assumedSpace &&
+        follows(predicted, input.bike)) {
+        firstStep = input.step;
+        pathsKept++;
+    } else {
+        bike.restoreState(input.bike);
+        trajectory[input.step % trajectory.size()] = input.bike;
+        firstStep = input.step;
+        lastStep = input.step;
+        hasPath = true;
+        assumedSpace = input.spacePressed;
+        // Already in the air counts as a jump under way, so the next touchdown is a landing
+        airborneSteps = input.wheelOnGround ? 0 : MIN_AIRBORNE_STEPS;
+        outcome = LandingOutcome::None;
+        leftGround = false;
+    }
+
+    extend(start);
+    cost.record(std::chrono::steady_clock::now() - start);
+}
+
+void LandingPredictor::extend(std::chrono::steady_clock::time_point start) {
+    while (!isFinished() && std::chrono::steady_clock::now() - start < PREDICTION_BUDGET) {
+        stepClone();
+    }
+    if (isFinished()) {
+        publish();
+    }
+}
+
+void LandingPredictor::syncGround(const Input& input) {
+    // Clone the chunks from just behind the bike to PREDICTION_CHUNKS_AHEAD ahead; the rest
+    // of the track is out of reach within the horizon. New ground may cross the old path
+    if (input.originChunk != originChunk) {
+        for (const GroundClone& clone : ground) {
+            world.DestroyBody(clone.body);
+        }
+        ground.clear();
+        originChunk = input.originChunk;
+        hasPath = false;
+    }
+    int bikeChunk = originChunk + static_cast<int>(std::floor(input.bike.position.x * SCALE / SEGMENT_LENGTH));
+    int first = bikeChunk - 1;
+    int last = bikeChunk + PREDICTION_CHUNKS_AHEAD;
+    for (size_t i = 0; i < ground.size();) {
+        if (ground[i].index < first || ground[i].index > last) {
+            world.DestroyBody(ground[i].body);
+            ground[i] = ground.back();
+            ground.pop_back();
+        } else {
+            ++i;
+        }
+    }
+    for (const ChunkHandle& chunk : input.chunks) {
+        int index = chunk->index;
+        if (index < first || index > last ||
+            std::any_of(ground.begin(), ground.end(), [index](const GroundClone& clone) { return clone.index == index; })) {
+            continue;
+        }
+        float startX = (index - originChunk) * SEGMENT_LENGTH;
+        ground.push_back(GroundClone{index, createChunkBody(&world, *chunk, startX, chainVertices)});
+        hasPath = false;
+    }
+    groundStartX = groundEndX = 0.0f;
+    if (!ground.empty()) {
+        auto span = std::minmax_element(ground.begin(), ground.end(), [](const GroundClone& a, const GroundClone& b) {
+            return a.index < b.index;
+        });
+        groundStartX = (span.first->index - originChunk) * SEGMENT_LENGTH;
+        groundEndX = (span.second->index + 1 - originChunk) * SEGMENT_LENGTH;
+    }
+}
+
+void LandingPredictor::stepClone() {
+    // One step as Simulation::step takes it, then look at what the clone touches
+    bike.updatePhysics(assumedSpace);
+    world.Step(PHYSICS_TIMESTEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    lastStep++;
+    BikeState& state = trajectory[lastStep % trajectory.size()];
+    bike.saveState(state);
+    float x = state.position.x * SCALE;
+    if (x < groundStartX || x > groundEndX) {
+        // Past the cloned ground the clone would fall through; what happens there is unknown
+        leftGround = true;
+        return;
+    }
+
+    bool frameTouching = false;
+    bool wheelTouching = false;
+    for (b2ContactEdge* edge = bike.getBody()->GetContactList(); edge; edge = edge->next) {
+        b2Contact* contact = edge->contact;
+        if (!contact->IsTouching()) {
+            continue;
+        }
+        FixtureCategory a = fixtureCategory(contact->GetFixtureA());
+        FixtureCategory b = fixtureCategory(contact->GetFixtureB());
+        frameTouching = frameTouching || a == FixtureCategory::Frame || b == FixtureCategory::Frame;
+        wheelTouching = wheelTouching || a == FixtureCategory::Wheel || b == FixtureCategory::Wheel;
+    }
+    if (frameTouching || state.position.y * SCALE > FALL_LIMIT_Y) {
+        outcome = LandingOutcome::Crashes;
+    } else if (wheelTouching) {
+        if (airborneSteps >= MIN_AIRBORNE_STEPS) {
+            outcome = LandingOutcome::Lands;
+        }
+        airborneSteps = 0;
+    } else {
+        airborneSteps++;
+    }
+}
+
+void LandingPredictor::publish() {
+    // Thin the path to every other step, always ending on the last one
+    LandingPrediction& prediction = results.back();
+    prediction.fromStep = firstStep;
+    prediction.originChunk = originChunk;
+    prediction.outcome = outcome;
+    prediction.atStep = lastStep;
+    prediction.touchdown = poseOf(trajectory[lastStep % trajectory.size()]);
+    prediction.pathLength = 0;
+    for (unsigned long step = firstStep; step < lastStep && prediction.pathLength + 1 < prediction.path.size();
+         step += 2) {
+        prediction.path[prediction.pathLength++] = poseOf(trajectory[step % trajectory.size()]);
+    }
+    prediction.path[prediction.pathLength++] = prediction.touchdown;
+    results.publish();
+}
+
+void LandingPredictor::workerLoop() {
+    // Predict from each new state, else carry on the current path one budget at a time;
+    // with nothing new and the path finished, nap briefly
+    while (running.load(std::memory_order_relaxed)) {
+        if (inputs.update()) {
+            predict(inputs.front());
+        } else if (hasPath && !isFinished()) {
+            extend(std::chrono::steady_clock::now());
+        } else {
+            std::this_thread::sleep_for(WORKER_IDLE);
+        }
+    }
+}
+
+void LandingPredictor::printStats(const char* label) const {
+    cost.print(label);
+    if (predictions > 0) {
+        std::cout << std::fixed << std::setprecision(1) << label << ": path kept on "
+                  << 100.0 * pathsKept / predictions << "% of " << predictions << " updates" << std::endl;
+    }
+}
+
+void PredictionAccuracy::observe(const RenderSnapshot& snapshot, const LandingPrediction& shown) {
+    // Follow the real bike step by step; a restart or rewind breaks the timeline, so start afresh
+    if (snapshot.run != lastRun || snapshot.step < lastStep) {
+        lastRun = snapshot.run;
+        lastStep = snapshot.step;
+        airborneSteps = 0;
+        crashSeen = false;
+        shownCount = 0;
+        return;
+    }
+    if (snapshot.step == lastStep) {
+        return;
+    }
+    unsigned long elapsed = snapshot.step - lastStep;
+    lastStep = snapshot.step;
+
+    double x = snapshot.player.current.x + static_cast<double>(snapshot.originChunk) * SEGMENT_LENGTH;
+    float angle = snapshot.player.current.angle;
+    if (snapshot.crash != CrashReason::None) {
+        if (!crashSeen) {
+            crashSeen = true;
+            score(LandingOutcome::Crashes, snapshot.step, x, angle);
+        }
+        return;
+    }
+    if (snapshot.wheelOnGround) {
+        if (airborneSteps >= MIN_AIRBORNE_STEPS) {
+            score(LandingOutcome::Lands, snapshot.step, x, angle);
+        }
+        airborneSteps = 0;
+    } else {
+        airborneSteps += elapsed;
+    }
+
+    Shown& entry = recent[shownCount % recent.size()];
+    shownCount++;
+    entry.step = snapshot.step;
+    entry.outcome = shown.outcome;
+    entry.atStep = shown.atStep;
+    entry.x = shown.touchdown.x + static_cast<double>(shown.originChunk) * SEGMENT_LENGTH;
+    entry.angle = shown.touchdown.angle;
+}
+
+void PredictionAccuracy::score(LandingOutcome actual, unsigned long step, double x, float angle) {
+    // Compare with the newest prediction shown at least PREDICTION_LEAD_STEPS earlier
+    outcomes++;
+    size_t available = std::min(shownCount, recent.size());
+    const Shown* match = nullptr;
+    for (size_t i = 1; i <= available; ++i) {
+        const Shown& entry = recent[(shownCount - i) % recent.size()];
+        if (entry.step + PREDICTION_LEAD_STEPS <= step) {
+            match = &entry;
+            break;
+        }
+    }
+    if (!match) {
+        return;
+    }
+    scored++;
+    if (match->outcome == actual) {
+        outcomeRight++;
+    }
+    if (actual == LandingOutcome::Crashes && match->outcome != LandingOutcome::Crashes) {
+        crashesMissed++;
+    }
+    if (actual != LandingOutcome::Crashes && match->outcome == LandingOutcome::Crashes) {
+        falseCrashes++;
+    }
+    if (match->outcome != LandingOutcome::None) {
+        double xError = std::abs(match->x - x);
+        touchdownsCompared++;
+        xErrorSum += xError;
+        xErrorMax = std::max(xErrorMax, xError);
+        stepErrorSum += std::abs(static_cast<double>(match->atStep) - static_cast<double>(step));
+        angleErrorSum += std::abs(std::remainder(match->angle - angle, 2.0f * PI));
+    }
+}
+
+void PredictionAccuracy::print(const char* label) const {
+    std::cout << std::fixed << std::setprecision(1) << label << ": " << outcomes << " touchdowns and crashes, "
+              << scored << " scored against the prediction shown " << PREDICTION_LEAD_STEPS * PHYSICS_TIMESTEP
+              << " s before" << std::endl;
+    if (scored == 0) {
+        return;
+    }
+    std::cout << "  outcome right " << 100.0 * outcomeRight / scored << "%, crashes missed " << crashesMissed
+              << ", false crash warnings " << falseCrashes << std::endl;
+    if (touchdownsCompared > 0) {
+        std::cout << "  touchdown error: x mean " << xErrorSum / touchdownsCompared << " px, max " << xErrorMax
+                  << " px; time mean " << stepErrorSum / touchdownsCompared << " steps; angle mean "
+                  << angleErrorSum / touchdownsCompared * 180.0 / PI << " deg" << std::endl;
+    }
+}
\ No newline at end of file
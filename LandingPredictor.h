@@ -0,0 +1,171 @@
+#ifndef LANDINGPREDICTOR_H
+#define LANDINGPREDICTOR_H
+
+#include "Bicycle.h"
+#include "LatencyStats.h"
+#include "SimulationThread.h"
+#include "TripleBuffer.h"
+#include <box2d/box2d.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// How far ahead the predictor looks, in physics steps (two seconds)
+const unsigned long PREDICTION_HORIZON_STEPS = 120;
+// Time a prediction may take per frame; one that runs out carries on next frame
+const std::chrono::microseconds PREDICTION_BUDGET(1000);
+// Ground chunks cloned ahead of the one under the bike; two seconds never cover more
+const int PREDICTION_CHUNKS_AHEAD = 2;
+// A bike off the ground for fewer steps than this has bounced rather than landed
+const unsigned long MIN_AIRBORNE_STEPS = 6;
+// Predictions are scored against what happened this many steps after they were shown
+const unsigned long PREDICTION_LEAD_STEPS = 30;
+
+enum class LandingOutcome {
+    None,
+    Lands,
+    Crashes
+};
+
+// Where the player is heading if Space stays as it is now
+struct LandingPrediction {
+    // Step of the state the path starts from; poses are relative to originChunk (see Terrain)
+    unsigned long fromStep = 0;
+    int originChunk = 0;
+    // What happens first within the horizon, at atStep, with the bike at touchdown
+    LandingOutcome outcome = LandingOutcome::None;
+    unsigned long atStep = 0;
+    RiderPose touchdown;
+    // Every other predicted pose from fromStep to atStep
+    std::array<RiderPose, PREDICTION_HORIZON_STEPS / 2 + 1> path;
+    size_t pathLength = 0;
+};
+
+// Forward-simulates the player in a b2World of its own: a clone of the bike
+// on clones of the few ground chunks around it, never touching the live
+// world. A prediction runs until the bike lands, crashes or reaches the
+// horizon, stepping for at most PREDICTION_BUDGET per call and carrying on
+// at the next one if it runs out. While the real bike stays on the predicted
+// path with the same Space state, the path is kept and only extended, so a
+// jump costs a few steps per frame after the first. With a worker, the
+// stepping moves to its own thread and submit() only hands the state over.
+class LandingPredictor {
+public:
+    explicit LandingPredictor(bool useWorker = false, const BikeParams& params = BikeParams());
+    ~LandingPredictor();
+    LandingPredictor(const LandingPredictor&) = delete;
+    LandingPredictor& operator=(const LandingPredictor&) = delete;
+
+    // Predicts from the player's state in snapshot, or queues it for the worker
+    void submit(const RenderSnapshot& snapshot);
+    // On frames without a new snapshot: spends this frame's budget extending an
+    // unfinished path. Does nothing with a worker, which carries on by itself
+    void advance();
+    // The newest finished prediction
+    const LandingPrediction& latest();
+    // Joins the worker, if any; the stats below are only read after this
+    void stop();
+    // Time spent on each submitted state in the call that took it in, and how
+    // often the previous path could be kept; carrying on a path counts as neither
+    void printStats(const char* label) const;
+
+private:
+    struct Input {
+        unsigned long step = 0;
+        BikeState bike;
+        bool spacePressed = false;
+        bool wheelOnGround = false;
+        std::vector<ChunkHandle> chunks;
+        int originChunk = 0;
+    };
+    struct GroundClone {
+        int index;
+        b2Body* body;
+    };
+
+    b2World world;
+    Bicycle bike;
+    std::vector<GroundClone> ground;
+    std::vector<b2Vec2> chainVertices;
+    int originChunk = 0;
+    // World x span of the cloned ground, in pixels; a path leaving it ends with no outcome
+    float groundStartX = 0.0f;
+    float groundEndX = 0.0f;
+
+    // Predicted states from firstStep to lastStep, at step % size; the clone is at lastStep
+    std::array<BikeState, PREDICTION_HORIZON_STEPS + 1> trajectory;
+    unsigned long firstStep = 0;
+    unsigned long lastStep = 0;
+    bool hasPath = false;
+    bool assumedSpace = false;
+    unsigned long airborneSteps = 0;
+    LandingOutcome outcome = LandingOutcome::None;
+    bool leftGround = false;
+
+    TripleBuffer<LandingPrediction> results;
+    Input syncInput;
+    bool useWorker;
+    TripleBuffer<Input> inputs;
+    std::thread worker;
+    std::atomic<bool> running{false};
+
+    LatencyStats cost;
+    unsigned long predictions = 0;
+    unsigned long pathsKept = 0;
+
+    bool isFinished() const;
+    // Takes in a new state, then extends the path within the budget
+    void predict(const Input& input);
+    void extend(std::chrono::steady_clock::time_point start);
+    void syncGround(const Input& input);
+    void stepClone();
+    void publish();
+    void workerLoop();
+};
+
+// Scores predictions against what the real bike then did: each real
+// touchdown or crash is compared with the prediction that was on screen
+// PREDICTION_LEAD_STEPS before it.
+class PredictionAccuracy {
+public:
+    // Once per frame, with the newest snapshot and the prediction drawn for it
+    void observe(const RenderSnapshot& snapshot, const LandingPrediction& shown);
+    size_t getOutcomeCount() const { return outcomes; }
+    void print(const char* label) const;
+
+private:
+    struct Shown {
+        unsigned long step;
+        LandingOutcome outcome;
+        unsigned long atStep;
+        // Absolute x, in pixels from the track's start
+        double x;
+        float angle;
+    };
+
+    // The predictions of the last steps, one per step
+    std::array<Shown, 2 * PREDICTION_LEAD_STEPS> recent{};
+    size_t shownCount = 0;
+    unsigned long lastStep = 0;
+    unsigned lastRun = ~0u;
+    unsigned long airborneSteps = 0;
+    bool crashSeen = false;
+
+    size_t outcomes = 0;
+    size_t scored = 0;
+    size_t outcomeRight = 0;
+    size_t crashesMissed = 0;
+    size_t falseCrashes = 0;
+    size_t touchdownsCompared = 0;
+    double xErrorSum = 0.0;
+    double xErrorMax = 0.0;
+    double stepErrorSum = 0.0;
+    double angleErrorSum = 0.0;
+
+    void score(LandingOutcome actual, unsigned long step, double x, float angle);
+};
+
+#endif // LANDINGPREDICTOR_H
\ No newline at end of file
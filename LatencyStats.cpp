@@ -0,0 +1,23 @@
+#include "LatencyStats.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+void LatencyStats::record(std::chrono::steady_clock::duration latency) {
+    samplesMs[recorded % CAPACITY] = std::chrono::duration<float, std::milli>(latency).count();
+    recorded++;
+}
+
+void LatencyStats::print(const char* label) const {
+    // Percentiles over the samples still in the ring
+    size_t count = std::min(recorded, CAPACITY);
+    if (count == 0) {
+        std::cout << label << ": no samples" << std::endl;
+        return;
+    }
+    std::array<float, CAPACITY> sorted = samplesMs;
+    std::sort(sorted.begin(), sorted.begin() + count);
+    std::cout << std::fixed << std::setprecision(1) << label << ": " << recorded << " samples, p50 "
+              << sorted[count / 2] << " ms, p95 " << sorted[std::min(count - 1, count * 95 / 100)]
+              << " ms, max " << sorted[count - 1] << " ms" << std::endl;
+}
\ No newline at end of file
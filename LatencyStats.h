@@ -0,0 +1,24 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// The most recent latency samples in a fixed ring, summarized as percentiles.
+// Recording never allocates, so it can run every frame.
+class LatencyStats {
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    void record(std::chrono::steady_clock::duration latency);
+    size_t getCount() const { return recorded; }
+    // Prints e.g. "Space press to present: 42 samples, p50 18.3 ms, p95 31.0 ms, max 35.2 ms"
+    void print(const char* label) const;
+
+private:
+    std::array<float, CAPACITY> samplesMs{};
+    size_t recorded = 0;
+};
+
+#endif // LATENCYSTATS_H
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "Profiler.h"
+
+#ifdef ENABLE_PROFILER
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+const size_t PHASE_COUNT = static_cast<size_t>(ProfilePhase::Count);
+}
+
+thread_local ProfileScope* ProfileScope::innermost = nullptr;
+
+const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Frame: return "frame";
+        case ProfilePhase::HandleInput: return "handleInput";
+        case ProfilePhase::UpdatePhysics: return "updatePhysics";
+        case ProfilePhase::CheckGameOver: return "checkGameOver";
+        case ProfilePhase::TerrainExtend: return "terrainExtend";
+        case ProfilePhase::TerrainGenerate: return "terrainGenerate";
+        case ProfilePhase::UpdateVisuals: return "updateVisuals";
+        case ProfilePhase::Render: return "render";
+        case ProfilePhase::Display: return "display";
+        case ProfilePhase::Capture: return "capture";
+        case ProfilePhase::Predict: return "predict";
+        default: return "unknown";
+    }
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : epoch(std::chrono::steady_clock::now())
+    , events(EVENT_CAPACITY)
+    , frameHistory(FRAME_HISTORY)
+{
+}
+
+uint64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+unsigned Profiler::threadIndex() {
+    thread_local unsigned index = threadCount++;
+    return index;
+}
+
+void Profiler::record(ProfilePhase phase, uint64_t startNs, uint64_t endNs, uint64_t nestedNs) {
+    // Claim a slot; the sequence is published last so readers can skip torn slots
+    uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Event& event = events[index % EVENT_CAPACITY];
+    uint64_t duration = endNs - startNs;
+    event.sequence.store(0, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.packed.store(duration << 16 | (threadIndex() & 0xFF) << 8 | static_cast<uint64_t>(phase),
+                       std::memory_order_relaxed);
+    event.sequence.store(index + 1, std::memory_order_release);
+
+    if (phase != ProfilePhase::Frame) {
+        currentFrame[static_cast<size_t>(phase)].fetch_add(duration - nestedNs, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::endFrame() {
+    uint64_t end = now();
+    if (frameStartNs != 0) {
+        record(ProfilePhase::Frame, frameStartNs, end);
+        auto& frame = frameHistory[framesRecorded % FRAME_HISTORY];
+        frame[static_cast<size_t>(ProfilePhase::Frame)] = (end - frameStartNs) / 1e6f;
+        for (size_t i = 1; i < PHASE_COUNT; ++i) {
+            frame[i] = currentFrame[i].exchange(0, std::memory_order_relaxed) / 1e6f;
+        }
+        framesRecorded++;
+    }
+    frameStartNs = end;
+}
+
+ProfileStats Profiler::computeStats() const {
+    ProfileStats stats;
+    size_t count = std::min(framesRecorded, FRAME_HISTORY);
+    if (count == 0) {
+        return stats;
+    }
+
+    std::array<float, FRAME_HISTORY> frameTimes;
+    for (size_t i = 0; i < count; ++i) {
+        frameTimes[i] = frameHistory[i][0];
+        for (size_t p = 1; p < PHASE_COUNT; ++p) {
+            stats.phaseMs[p] += frameHistory[i][p] / count;
+        }
+    }
+    std::sort(frameTimes.begin(), frameTimes.begin() + count);
+    stats.frameP50 = frameTimes[count / 2];
+    stats.frameP99 = frameTimes[std::min(count - 1, count * 99 / 100)];
+    stats.frameMax = frameTimes[count - 1];
+    stats.phaseMs[0] = stats.frameP50;
+    return stats;
+}
+
+bool Profiler::exportTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: Could not write trace " << path << std::endl;
+        return false;
+    }
+    bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+
+    uint64_t end = writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > EVENT_CAPACITY ? end - EVENT_CAPACITY : 0;
+    bool first = true;
+    out << (csv ? "phase,thread,start_us,duration_us\n" : "{\"traceEvents\":[\n");
+    for (uint64_t i = begin; i < end; ++i) {
+        const Event& event = events[i % EVENT_CAPACITY];
+        if (event.sequence.load(std::memory_order_acquire) != i + 1) {
+            continue;
+        }
+        uint64_t packed = event.packed.load(std::memory_order_relaxed);
+        double startUs = event.startNs.load(std::memory_order_relaxed) / 1000.0;
+        double durationUs = (packed >> 16) / 1000.0;
+        unsigned thread = (packed >> 8) & 0xFF;
+        const char* name = profilePhaseName(static_cast<ProfilePhase>(packed & 0xFF));
+        if (csv) {
+            out << name << ',' << thread << ',' << startUs << ',' << durationUs << '\n';
+        } else {
+            out << (first ? "" : ",\n") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << thread << ",\"ts\":" << startUs << ",\"dur\":" << durationUs << "}";
+        }
+        first = false;
+    }
+    if (!csv) {
+        out << "\n]}\n";
+    }
+    std::cout << "Wrote profile trace to " << path << std::endl;
+    return true;
+}
+
+#endif // ENABLE_PROFILER
\ No newline at end of file
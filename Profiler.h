@@ -0,0 +1,122 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Frame phase profiler. Build with -DENABLE_PROFILER (PROFILE=1 bash run.sh)
+// to enable it; otherwise PROFILE_SCOPE and PROFILE_FRAME_END compile to nothing.
+
+#ifdef ENABLE_PROFILER
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ProfilePhase : uint8_t {
+    Frame,
+    HandleInput,
+    UpdatePhysics,
+    CheckGameOver,
+    TerrainExtend,
+    TerrainGenerate,
+    UpdateVisuals,
+    Render,
+    Display,
+    Capture,
+    Predict,
+    Count
+};
+
+const char* profilePhaseName(ProfilePhase phase);
+
+struct ProfileStats {
+    float frameP50 = 0.0f;
+    float frameP99 = 0.0f;
+    float frameMax = 0.0f;
+    // Average milliseconds per frame spent in each phase, excluding the phases nested in it
+    std::array<float, static_cast<size_t>(ProfilePhase::Count)> phaseMs{};
+};
+
+// Records timed phases into a fixed-size ring buffer. Any thread may record;
+// slots are claimed with one atomic increment, so recording never blocks.
+class Profiler {
+public:
+    static constexpr size_t EVENT_CAPACITY = 1 << 16;
+    static constexpr size_t FRAME_HISTORY = 512;
+
+    static Profiler& instance();
+
+    uint64_t now() const;
+    // The trace keeps the whole span; the frame's phase totals get it less nestedNs,
+    // the time spent in phases nested inside it, so no time is counted twice
+    void record(ProfilePhase phase, uint64_t startNs, uint64_t endNs, uint64_t nestedNs = 0);
+    // Closes the current frame; call once per main loop iteration
+    void endFrame();
+    // Percentiles over the recent frame history, for the overlay
+    ProfileStats computeStats() const;
+    // Writes the buffered events as Chrome trace-event JSON, or CSV if path ends in .csv
+    bool exportTrace(const std::string& path) const;
+
+private:
+    struct Event {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> packed{0}; // duration << 16 | thread << 8 | phase
+    };
+
+    Profiler();
+
+    std::chrono::steady_clock::time_point epoch;
+    std::vector<Event> events;
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<unsigned> threadCount{0};
+
+    // Per-phase time of the frame in progress, then history of closed frames
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(ProfilePhase::Count)> currentFrame{};
+    std::vector<std::array<float, static_cast<size_t>(ProfilePhase::Count)>> frameHistory;
+    size_t framesRecorded = 0;
+    uint64_t frameStartNs = 0;
+
+    unsigned threadIndex();
+};
+
+// Times the enclosing scope. Scopes on one thread form a stack, so a scope
+// opened inside another (TerrainExtend inside UpdatePhysics) is taken out of
+// its parent's exclusive time
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase)
+        : phase(phase), parent(innermost), start(Profiler::instance().now()) { innermost = this; }
+    ~ProfileScope() {
+        uint64_t end = Profiler::instance().now();
+        innermost = parent;
+        if (parent) {
+            parent->nestedNs += end - start;
+        }
+        Profiler::instance().record(phase, start, end, nestedNs);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    static thread_local ProfileScope* innermost;
+    ProfilePhase phase;
+    ProfileScope* parent;
+    uint64_t start;
+    uint64_t nestedNs = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfilePhase::phase)
+#define PROFILE_FRAME_END() Profiler::instance().endFrame()
+
+#else
+
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "ProfilerOverlay.h"
+
+#ifdef ENABLE_PROFILER
+
+#include <cstdio>
+
+namespace {
+const float BAR_PIXELS_PER_MS = 12.0f;
+const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+const int REFRESH_FRAMES = 15;
+const size_t PHASE_COUNT = static_cast<size_t>(ProfilePhase::Count);
+}
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font) {
+    summaryText.setFont(font);
+    summaryText.setCharacterSize(14);
+    summaryText.setFillColor(sf::Color::White);
+    summaryText.setPosition(20.0f, 20.0f);
+
+    phaseText.setFont(font);
+    phaseText.setCharacterSize(12);
+    phaseText.setFillColor(sf::Color::White);
+
+    background.setSize(sf::Vector2f(420.0f, 60.0f + 18.0f * PHASE_COUNT));
+    background.setPosition(10.0f, 10.0f);
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+
+    budgetLine.setSize(sf::Vector2f(1.0f, 18.0f * (PHASE_COUNT - 1)));
+    budgetLine.setPosition(130.0f + FRAME_BUDGET_MS * BAR_PIXELS_PER_MS, 50.0f);
+    budgetLine.setFillColor(sf::Color::Red);
+}
+
+void ProfilerOverlay::render(sf::RenderTarget& target) {
+    if (!visible) {
+        return;
+    }
+    // Refresh the numbers a few times a second so they stay readable
+    if (--framesUntilRefresh <= 0) {
+        stats = Profiler::instance().computeStats();
+        framesUntilRefresh = REFRESH_FRAMES;
+        char line[128];
+        std::snprintf(line, sizeof(line), "frame  p50 %.2f ms   p99 %.2f ms   max %.2f ms",
+                      stats.frameP50, stats.frameP99, stats.frameMax);
+        summaryText.setString(line);
+    }
+
+    sf::View previous = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(background);
+    target.draw(summaryText);
+
+    // One row per phase, skipping the whole-frame entry
+    char label[64];
+    for (size_t i = 1; i < PHASE_COUNT; ++i) {
+        float y = 50.0f + 18.0f * (i - 1);
+        std::snprintf(label, sizeof(label), "%s %.2f", profilePhaseName(static_cast<ProfilePhase>(i)), stats.phaseMs[i]);
+        phaseText.setString(label);
+        phaseText.setPosition(20.0f, y);
+        target.draw(phaseText);
+
+        bar.setSize(sf::Vector2f(stats.phaseMs[i] * BAR_PIXELS_PER_MS, 12.0f));
+        bar.setPosition(130.0f, y + 2.0f);
+        bar.setFillColor(stats.phaseMs[i] > FRAME_BUDGET_MS / 2 ? sf::Color::Red : sf::Color::Green);
+        target.draw(bar);
+    }
+    target.draw(budgetLine);
+    target.setView(previous);
+}
+
+#endif // ENABLE_PROFILER
\ No newline at end of file
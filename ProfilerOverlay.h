@@ -0,0 +1,30 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include "Profiler.h"
+
+#ifdef ENABLE_PROFILER
+
+#include <SFML/Graphics.hpp>
+
+// HUD with frame time percentiles and one bar per phase; toggled with F3
+class ProfilerOverlay {
+public:
+    ProfilerOverlay(const sf::Font& font);
+    void toggle() { visible = !visible; }
+    void render(sf::RenderTarget& target);
+
+private:
+    bool visible = false;
+    int framesUntilRefresh = 0;
+    ProfileStats stats;
+    sf::Text summaryText;
+    sf::Text phaseText;
+    sf::RectangleShape background;
+    sf::RectangleShape bar;
+    sf::RectangleShape budgetLine;
+};
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILEROVERLAY_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "ResourceCache.h"
+#include <cstdlib>
+#include <iostream>
+
+#ifdef EMBED_FONT
+// The font file is assembled straight into .rodata; the path is relative to the build directory
+extern "C" const unsigned char embeddedFontData[];
+extern "C" const unsigned char embeddedFontEnd[];
+__asm__(
+    ".section .rodata\n"
+    ".global embeddedFontData\n"
+    ".global embeddedFontEnd\n"
+    ".balign 16\n"
+    "embeddedFontData:\n"
+    ".incbin \"DejaVuSans.ttf\"\n"
+    "embeddedFontEnd:\n"
+    ".previous\n");
+#endif
+
+ResourceCache& ResourceCache::instance() {
+    static ResourceCache cache;
+    return cache;
+}
+
+const sf::Font& ResourceCache::getFont(const std::string& name) {
+    // Load on first request, then hand out the same font
+    auto it = fonts.find(name);
+    if (it != fonts.end()) {
+        return *it->second;
+    }
+
+    std::unique_ptr<sf::Font> font(new sf::Font());
+    bool loaded = false;
+#ifdef EMBED_FONT
+    if (name == DEFAULT_FONT) {
+        // SFML reads glyphs from this memory lazily, which is fine since it lives as long as the binary
+        loaded = font->loadFromMemory(embeddedFontData, embeddedFontEnd - embeddedFontData);
+    }
+#endif
+    if (!loaded && !font->loadFromFile(name)) {
+        std::cerr << "Error: Could not load font " << name << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    return *fonts.emplace(name, std::move(font)).first->second;
+}
\ No newline at end of file
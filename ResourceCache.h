@@ -0,0 +1,30 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+
+const char* const DEFAULT_FONT = "DejaVuSans.ttf";
+
+// Process-wide cache of loaded assets. Each file is parsed once and shared by
+// reference; references stay valid for the lifetime of the process.
+// Build with -DEMBED_FONT (EMBED_FONT=1 bash run.sh) to compile DEFAULT_FONT
+// into the binary so it is loaded from memory instead of the working directory.
+class ResourceCache {
+public:
+    static ResourceCache& instance();
+
+    // Exits the process if the font cannot be loaded, as the game can't draw text without it
+    const sf::Font& getFont(const std::string& name);
+
+private:
+    ResourceCache() = default;
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    std::map<std::string, std::unique_ptr<sf::Font>> fonts;
+};
+
+#endif // RESOURCECACHE_H
\ No newline at end of file
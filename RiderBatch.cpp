@@ -0,0 +1,71 @@
+#include "RiderBatch.h"
+#include "Bicycle.h"
+#include <cmath>
+
+namespace {
+// Same geometry the bike shapes used: a 60x20 frame and 15 px wheels, in bike-local pixels
+const float FRAME_LEFT = -30.0f;
+const float FRAME_RIGHT = 30.0f;
+const float FRAME_TOP = -15.0f;
+const float FRAME_BOTTOM = 5.0f;
+const float WHEEL_OFFSET_X = 20.0f;
+const float WHEEL_OFFSET_Y = 5.0f;
+const float WHEEL_RADIUS = 15.0f;
+}
+
+RiderBatch::RiderBatch() : vertices(sf::Triangles) {
+    for (size_t i = 0; i <= WHEEL_SEGMENTS; ++i) {
+        float theta = 2.0f * PI * i / WHEEL_SEGMENTS;
+        wheelOutline[i] = sf::Vector2f(std::cos(theta), std::sin(theta));
+    }
+}
+
+void RiderBatch::reserve(size_t riderCount) {
+    // sf::VertexArray has no reserve, but clear() keeps what resize() allocated
+    vertices.resize(riderCount * VERTICES_PER_RIDER);
+    vertices.clear();
+}
+
+void RiderBatch::clear() {
+    vertices.clear();
+}
+
+void RiderBatch::add(sf::Vector2f position, float angle, const RiderStyle& style) {
+    // Write the two wheel fans and then the frame, so the frame is drawn on top
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    auto toWorld = [&](float x, float y) {
+        return sf::Vector2f(position.x + x * c - y * s, position.y + x * s + y * c);
+    };
+
+    size_t base = vertices.getVertexCount();
+    vertices.resize(base + VERTICES_PER_RIDER);
+    sf::Vertex* out = &vertices[base];
+
+    for (float side : {-1.0f, 1.0f}) {
+        // A circle looks the same at any rotation, so only its center is transformed
+        sf::Vector2f center = toWorld(side * WHEEL_OFFSET_X, WHEEL_OFFSET_Y);
+        for (size_t i = 0; i < WHEEL_SEGMENTS; ++i) {
+            *out++ = sf::Vertex(center, style.wheels);
+            *out++ = sf::Vertex(center + WHEEL_RADIUS * wheelOutline[i], style.wheels);
+            *out++ = sf::Vertex(center + WHEEL_RADIUS * wheelOutline[i + 1], style.wheels);
+        }
+    }
+
+    sf::Vector2f topLeft = toWorld(FRAME_LEFT, FRAME_TOP);
+    sf::Vector2f topRight = toWorld(FRAME_RIGHT, FRAME_TOP);
+    sf::Vector2f bottomRight = toWorld(FRAME_RIGHT, FRAME_BOTTOM);
+    sf::Vector2f bottomLeft = toWorld(FRAME_LEFT, FRAME_BOTTOM);
+    *out++ = sf::Vertex(topLeft, style.frame);
+    *out++ = sf::Vertex(topRight, style.frame);
+    *out++ = sf::Vertex(bottomRight, style.frame);
+    *out++ = sf::Vertex(topLeft, style.frame);
+    *out++ = sf::Vertex(bottomRight, style.frame);
+    *out++ = sf::Vertex(bottomLeft, style.frame);
+}
+
+void RiderBatch::render(sf::RenderTarget& target) const {
+    if (vertices.getVertexCount() > 0) {
+        target.draw(vertices);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef RIDERBATCH_H
+#define RIDERBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+struct RiderStyle {
+    sf::Color frame;
+    sf::Color wheels;
+};
+
+const RiderStyle PLAYER_STYLE{sf::Color(0, 0, 255), sf::Color(255, 0, 0)};
+const RiderStyle GHOST_STYLE{sf::Color(0, 0, 255, 70), sf::Color(255, 0, 0, 70)};
+const size_t WHEEL_SEGMENTS = 16;
+
+// All bikes of a frame in one triangle list, so any number of riders costs a
+// single draw call. clear() keeps the buffer, so rebuilding it every frame
+// does not allocate once it has grown to the rider count.
+class RiderBatch {
+public:
+    static constexpr size_t VERTICES_PER_RIDER = 2 * WHEEL_SEGMENTS * 3 + 6;
+
+    RiderBatch();
+    // Empties the batch and makes room for riderCount bikes, so later frames never allocate
+    void reserve(size_t riderCount);
+    void clear();
+    // Appends a bike at a position in pixels, rotated by angle radians
+    void add(sf::Vector2f position, float angle, const RiderStyle& style);
+    void render(sf::RenderTarget& target) const;
+    size_t getRiderCount() const { return vertices.getVertexCount() / VERTICES_PER_RIDER; }
+
+private:
+    sf::VertexArray vertices;
+    // Unit circle points, shared by every wheel
+    std::array<sf::Vector2f, WHEEL_SEGMENTS + 1> wheelOutline;
+};
+
+#endif // RIDERBATCH_H
\ No newline at end of file
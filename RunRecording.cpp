@@ -0,0 +1,149 @@
+#include "RunRecording.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+const char RUN_MAGIC[4] = {'R', 'D', 'R', '1'};
+
+void writeLE(std::vector<char>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+bool readLE(const std::vector<char>& in, size_t& pos, uint64_t& value, int bytes) {
+    if (pos + bytes > in.size()) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[pos++])) << (8 * i);
+    }
+    return true;
+}
+
+void writeVarint(std::vector<char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(const std::vector<char>& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+RunRecording::RunRecording(uint32_t seed) : seed(seed) {
+}
+
+void RunRecording::push(bool spacePressed) {
+    // Extend the current run, or open a new one when the state flips
+    bool currentPressed = runEnds.size() % 2 == 0;
+    if (runEnds.empty() || spacePressed != currentPressed) {
+        if (runEnds.empty() && spacePressed) {
+            runEnds.push_back(0); // empty leading released run
+        }
+        runEnds.push_back(stepCount);
+    }
+    stepCount++;
+    runEnds.back() = stepCount;
+}
+
+bool RunRecording::isSpacePressed(unsigned long step) const {
+    // Find the run containing this step; odd runs are pressed
+    auto it = std::upper_bound(runEnds.begin(), runEnds.end(), step);
+    if (it == runEnds.end()) {
+        return false;
+    }
+    return (it - runEnds.begin()) % 2 == 1;
+}
+
+bool RunRecording::save(const std::string& path) const {
+    std::vector<char> data(RUN_MAGIC, RUN_MAGIC + 4);
+    writeLE(data, seed, 4);
+    writeLE(data, stepCount, 8);
+    unsigned long runStart = 0;
+    for (unsigned long end : runEnds) {
+        writeVarint(data, end - runStart);
+        runStart = end;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Could not write run file " << path << std::endl;
+        return false;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool RunRecording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Could not open run file " << path << std::endl;
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 4;
+    uint64_t fileSeed = 0;
+    uint64_t fileSteps = 0;
+    if (data.size() < 4 || !std::equal(RUN_MAGIC, RUN_MAGIC + 4, data.begin())
+        || !readLE(data, pos, fileSeed, 4) || !readLE(data, pos, fileSteps, 8)) {
+        std::cerr << "Error: " << path << " is not a run file" << std::endl;
+        return false;
+    }
+
+    std::vector<unsigned long> ends;
+    unsigned long covered = 0;
+    while (covered < fileSteps) {
+        uint64_t length = 0;
+        if (!readVarint(data, pos, length)) {
+            std::cerr << "Error: Run file " << path << " is truncated" << std::endl;
+            return false;
+        }
+        covered += length;
+        ends.push_back(covered);
+    }
+
+    seed = static_cast<uint32_t>(fileSeed);
+    stepCount = covered;
+    runEnds = std::move(ends);
+    return true;
+}
+
+RecordingInput::RecordingInput(InputSource& source, RunRecording& recording)
+    : source(source)
+    , recording(recording)
+{
+}
+
+bool RecordingInput::isSpacePressed(unsigned long step) {
+    bool pressed = source.isSpacePressed(step);
+    if (step != recording.getStepCount()) {
+        stopped = true;
+    }
+    if (!stopped) {
+        recording.push(pressed);
+    }
+    return pressed;
+}
+
+ReplayInput::ReplayInput(const RunRecording& recording) : recording(recording) {
+}
+
+bool ReplayInput::isSpacePressed(unsigned long step) {
+    return recording.isSpacePressed(step);
+}
\ No newline at end of file
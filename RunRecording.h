@@ -0,0 +1,63 @@
+#ifndef RUNRECORDING_H
+#define RUNRECORDING_H
+
+#include "InputSource.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The Space state of every physics step of one run, plus the terrain seed.
+// Stored run-length encoded: alternating released/pressed run lengths,
+// starting with a (possibly empty) released run.
+//
+// File layout (little endian):
+//   "RDR1"      magic
+//   uint32      seed
+//   uint64      step count
+//   varint...   run lengths (LEB128), until the step count is covered
+class RunRecording {
+public:
+    RunRecording(uint32_t seed = 0);
+    void push(bool spacePressed);
+    bool isSpacePressed(unsigned long step) const;
+    unsigned long getStepCount() const { return stepCount; }
+    uint32_t getSeed() const { return seed; }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    uint32_t seed;
+    unsigned long stepCount = 0;
+    // runEnds[i] is the step at which run i stops; even runs are released
+    std::vector<unsigned long> runEnds;
+};
+
+// Passes another source through and records what it returned.
+// Only the first run is kept: recording stops once the step counter restarts.
+class RecordingInput : public InputSource {
+public:
+    RecordingInput(InputSource& source, RunRecording& recording);
+    bool isSpacePressed(unsigned long step) override;
+    void onSpaceEvent(bool pressed, InputClock::time_point at) override { source.onSpaceEvent(pressed, at); }
+    void advanceTo(InputClock::time_point deadline) override { source.advanceTo(deadline); }
+    void discardUntil(InputClock::time_point now) override { source.discardUntil(now); }
+    InputClock::time_point getLastPressTime() const override { return source.getLastPressTime(); }
+
+private:
+    InputSource& source;
+    RunRecording& recording;
+    bool stopped = false;
+};
+
+// Plays a recording back; Space is released once it runs out
+class ReplayInput : public InputSource {
+public:
+    ReplayInput(const RunRecording& recording);
+    bool isSpacePressed(unsigned long step) override;
+
+private:
+    const RunRecording& recording;
+};
+
+#endif // RUNRECORDING_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "SceneRenderer.h"
+#include "ResourceCache.h"
+#include <cmath>
+#include <cstdio>
+
+SceneRenderer::SceneRenderer(size_t riderCount)
+    : view(sf::FloatRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT))
+{
+    riders.reserve(riderCount);
+
+    // Score centered at the top, in the font everything else shares
+    scoreText.setFont(ResourceCache::instance().getFont(DEFAULT_FONT));
+    scoreText.setCharacterSize(48);
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setStyle(sf::Text::Bold);
+    setScore(0);
+}
+
+void SceneRenderer::setScore(int value) {
+    // Rewrite the digits into the reused string; std::to_string and a fresh sf::String would allocate
+    score = value;
+    char digits[16];
+    std::snprintf(digits, sizeof(digits), "%d", value);
+    scoreString.clear();
+    for (const char* c = digits; *c; ++c) {
+        scoreString += sf::String(static_cast<sf::Uint32>(*c));
+    }
+    scoreText.setString(scoreString);
+    sf::FloatRect textBounds = scoreText.getLocalBounds();
+    scoreText.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
+}
+
+void SceneRenderer::updateCamera(const RenderSnapshot& snapshot, float alpha, float frameTime) {
+    // Move the camera with the world when the simulation shifts its origin (or resets it)
+    if (snapshot.originChunk != viewOriginChunk) {
+        view.move((viewOriginChunk - snapshot.originChunk) * SEGMENT_LENGTH, 0.0f);
+        viewOriginChunk = snapshot.originChunk;
+    }
+    sf::Vector2f target(interpolate(snapshot.player, alpha).x, 300.0f);
+    sf::Vector2f current = view.getCenter();
+    float smoothing = 1.0f - std::pow(0.9f, frameTime * 60.0f);
+    view.setCenter(current + (target - current) * smoothing);
+}
+
+void SceneRenderer::render(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha) {
+    target.setView(view);
+    target.clear(sf::Color::Black);
+    terrainRenderer.render(target, snapshot.chunks, snapshot.originChunk);
+    renderRiders(target, snapshot, alpha);
+    // Keep the score at the top of the view as it follows the bike
+    sf::Vector2f viewCenter = view.getCenter();
+    scoreText.setPosition(viewCenter.x, 40.0f + viewCenter.y - SCREEN_HEIGHT / 2.0f);
+    target.draw(scoreText);
+}
+
+void SceneRenderer::renderRiders(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha) {
+    // Rebuild the batch from this frame's bike poses: ghosts on screen first, the player on top
+    float left = view.getCenter().x - view.getSize().x / 2.0f - RIDER_CULL_MARGIN;
+    float right = view.getCenter().x + view.getSize().x / 2.0f + RIDER_CULL_MARGIN;
+    riders.clear();
+    for (const RiderSnapshot& ghost : snapshot.ghosts) {
+        RiderPose pose = interpolate(ghost, alpha);
+        if (pose.x > left && pose.x < right) {
+            riders.add(sf::Vector2f(pose.x, pose.y), pose.angle, GHOST_STYLE);
+        }
+    }
+    RiderPose player = interpolate(snapshot.player, alpha);
+    riders.add(sf::Vector2f(player.x, player.y), player.angle, PLAYER_STYLE);
+    riders.render(target);
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+
+#include "RiderBatch.h"
+#include "SimulationThread.h"
+#include "TerrainRenderer.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+const int SCREEN_HEIGHT = 700;
+const int SCREEN_WIDTH = 1500;
+// Riders this far outside the view horizontally are left out of the batch
+const float RIDER_CULL_MARGIN = 60.0f;
+
+// Draws a RenderSnapshot as the game shows it: terrain, riders and the score,
+// through a camera that follows the player. Game draws it to the window, or
+// to an offscreen texture when capturing; the offline capture mode uses it
+// without a window at all.
+class SceneRenderer {
+public:
+    // Room for riderCount bikes up front, so the batch never grows mid-run
+    explicit SceneRenderer(size_t riderCount);
+    void setScore(int value);
+    int getScore() const { return score; }
+    // Floating origin the camera's coordinates are relative to
+    int getViewOriginChunk() const { return viewOriginChunk; }
+    // Moves the camera towards the player, at the same rate whatever the frame rate
+    void updateCamera(const RenderSnapshot& snapshot, float alpha, float frameTime);
+    // Clears target and draws the scene through the camera; leaves the camera view set
+    void render(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha);
+
+private:
+    sf::View view;
+    // Floating origin the view's coordinates are relative to
+    int viewOriginChunk = 0;
+    TerrainRenderer terrainRenderer;
+    RiderBatch riders;
+
+    int score = 0;
+    // Refilled in place on every change, so updating the score does not allocate
+    sf::String scoreString;
+    sf::Text scoreText;
+
+    void renderRiders(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha);
+};
+
+#endif // SCENERENDERER_H
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "Simulation.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace {
+// Touching contacts between the ground and a bike's frame and wheels
+void countGroundContacts(b2Body* body, int& frame, int& wheel) {
+    frame = 0;
+    wheel = 0;
+    for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next) {
+        b2Contact* contact = edge->contact;
+        if (!contact->IsTouching()) {
+            continue;
+        }
+        FixtureCategory a = fixtureCategory(contact->GetFixtureA());
+        FixtureCategory b = fixtureCategory(contact->GetFixtureB());
+        if (a != FixtureCategory::Ground && b != FixtureCategory::Ground) {
+            continue;
+        }
+        FixtureCategory part = a == FixtureCategory::Ground ? b : a;
+        if (part == FixtureCategory::Frame) {
+            frame++;
+        } else if (part == FixtureCategory::Wheel) {
+            wheel++;
+        }
+    }
+}
+}
+
+Simulation::Simulation(uint32_t seed, const BikeParams& params, bool asyncTerrain)
+    : world(b2Vec2(0.0f, GRAVITY))
+    , seed(seed)
+    , bike(&world, params)
+    , terrain(&world, seed, asyncTerrain)
+{
+    world.SetContactListener(&contacts);
+}
+
+void Simulation::reset() {
+    reset(seed);
+}
+
+void Simulation::reset(uint32_t newSeed) {
+    // Rebuilding the terrain destroys fixtures, which ends their contacts right away;
+    // contacts on ground that stays end during the next step
+    contacts.clear();
+    // Back to the original origin first, so the start line is where the bikes respawn
+    shiftOrigin(-terrain.getOriginChunk());
+    bike.reset();
+    for (Ghost& ghost : ghosts) {
+        ghost.crashed = false;
+        ghost.bike->getBody()->SetEnabled(true);
+        ghost.bike->reset();
+    }
+    if (newSeed != seed) {
+        seed = newSeed;
+        terrain.reseed(newSeed);
+    } else {
+        terrain.reset();
+    }
+    consumeContactEvents();
+    score = 0;
+    stepCount = 0;
+    lastSpacePressed = false;
+}
+
+bool Simulation::step(bool spacePressed) {
+    // Apply input, step the world and keep the terrain ahead of the bike
+    bike.savePreviousState();
+    lastSpacePressed = spacePressed;
+    bool flipped = bike.updatePhysics(spacePressed);
+    if (flipped) {
+        score++;
+    }
+    for (Ghost& ghost : ghosts) {
+        if (!ghost.crashed) {
+            ghost.bike->savePreviousState();
+            ghost.bike->updatePhysics(ghost.input->isSpacePressed(stepCount));
+        }
+    }
+    contacts.clear();
+    world.Step(PHYSICS_TIMESTEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    stepCount++;
+    int playerChunk = static_cast<int>(std::floor(bike.getPosition().x * SCALE / SEGMENT_LENGTH));
+    if (playerChunk >= ORIGIN_SHIFT_CHUNKS) {
+        shiftOrigin(playerChunk);
+    }
+    {
+        PROFILE_SCOPE(TerrainExtend);
+        float frontX;
+        float backX;
+        riderSpan(frontX, backX);
+        terrain.extendIfNeeded(frontX, backX);
+    }
+    consumeContactEvents();
+    retireCrashedGhosts();
+    return flipped;
+}
+
+void Simulation::riderSpan(float& frontX, float& backX) const {
+    // In pixels, over the player and every ghost still riding
+    frontX = bike.getPosition().x;
+    backX = frontX;
+    for (const Ghost& ghost : ghosts) {
+        if (!ghost.crashed) {
+            float x = ghost.bike->getPosition().x;
+            frontX = std::max(frontX, x);
+            backX = std::min(backX, x);
+        }
+    }
+    frontX *= SCALE;
+    backX *= SCALE;
+}
+
+void Simulation::shiftOrigin(int chunkCount) {
+    // Move the world so x = 0 lies chunkCount chunks further along. Box2D moves every
+    // body, ground included; what it doesn't know about is shifted here
+    if (chunkCount == 0) {
+        return;
+    }
+    b2Vec2 newOrigin(chunkCount * SEGMENT_LENGTH / SCALE, 0.0f);
+    world.ShiftOrigin(newOrigin);
+    bike.shiftOrigin(newOrigin);
+    for (Ghost& ghost : ghosts) {
+        ghost.bike->shiftOrigin(newOrigin);
+    }
+    terrain.shiftOrigin(chunkCount);
+    originShifts++;
+}
+
+void Simulation::saveSnapshot(WorldSnapshot& out) const {
+    out.step = stepCount;
+    out.score = score;
+    out.originChunk = terrain.getOriginChunk();
+    bike.saveState(out.player);
+    out.ghosts.resize(ghosts.size());
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+        ghosts[i].bike->saveState(out.ghosts[i]);
+    }
+}
+
+void Simulation::restoreSnapshot(const WorldSnapshot& snapshot) {
+    // Disabling ghosts and detaching chunks end contacts right away, so their events are
+    // counted here; contacts of bodies that just moved end or begin during the next step
+    contacts.clear();
+    shiftOrigin(snapshot.originChunk - terrain.getOriginChunk());
+    bike.restoreState(snapshot.player);
+    for (size_t i = 0; i < ghosts.size() && i < snapshot.ghosts.size(); ++i) {
+        ghosts[i].bike->restoreState(snapshot.ghosts[i]);
+        ghosts[i].crashed = !snapshot.ghosts[i].enabled;
+    }
+    // Ghosts restored away from the player need ground under them too
+    float frontX;
+    float backX;
+    riderSpan(frontX, backX);
+    terrain.jumpTo(frontX, backX);
+    consumeContactEvents();
+    score = snapshot.score;
+    stepCount = snapshot.step;
+    lastSpacePressed = false;
+}
+
+double Simulation::getDistance() const {
+    // In double, so long runs keep centimetre resolution
+    return (bike.getPosition().x * SCALE + getOriginX() - BIKE_START_X) / SCALE;
+}
+
+void Simulation::addGhost(std::unique_ptr<InputSource> input, const BikeParams& params) {
+    // The body remembers its ghost slot (index + 1) so contact events map back in O(1)
+    Ghost ghost;
+    ghost.bike.reset(new Bicycle(&world, params));
+    ghost.bike->getBody()->GetUserData().pointer = ghosts.size() + 1;
+    ghost.input = std::move(input);
+    ghosts.push_back(std::move(ghost));
+    contacts.reserveRiders(ghosts.size() + 1);
+}
+
+void Simulation::retireCrashedGhosts() {
+    // Disabling a body ends its contacts; those events are dropped with the next clear()
+    const float maxDistance = GHOST_MAX_DISTANCE_CHUNKS * SEGMENT_LENGTH;
+    float playerX = bike.getPosition().x * SCALE;
+    for (Ghost& ghost : ghosts) {
+        if (ghost.crashed) {
+            continue;
+        }
+        b2Vec2 position = ghost.bike->getPosition();
+        if (ghost.frameGroundContacts > 0 || position.y * SCALE > FALL_LIMIT_Y ||
+            std::abs(position.x * SCALE - playerX) > maxDistance) {
+            ghost.crashed = true;
+            ghost.frameGroundContacts = 0;
+            ghost.bike->getBody()->SetEnabled(false);
+        }
+    }
+}
+
+void Simulation::consumeContactEvents() {
+    // Track how many bike fixtures touch the ground; only this step's events are visited.
+    // If some were lost the counts can't be patched up, so they are rebuilt instead
+    if (contacts.hasOverflowed()) {
+        recountContacts();
+        contacts.grow();
+        return;
+    }
+    for (const ContactEvent& event : contacts) {
+        int delta = event.begin ? 1 : -1;
+        if (event.body != bike.getBody()) {
+            uintptr_t slot = event.body->GetUserData().pointer;
+            if (slot != 0 && event.kind == ContactKind::FrameGround) {
+                ghosts[slot - 1].frameGroundContacts += delta;
+            }
+            continue;
+        }
+        if (event.kind == ContactKind::FrameGround) {
+            frameGroundContacts += delta;
+        } else {
+            wheelGroundContacts += delta;
+        }
+    }
+}
+
+void Simulation::recountContacts() {
+    countGroundContacts(bike.getBody(), frameGroundContacts, wheelGroundContacts);
+    int wheel = 0;
+    for (Ghost& ghost : ghosts) {
+        countGroundContacts(ghost.bike->getBody(), ghost.frameGroundContacts, wheel);
+    }
+}
+
+CrashReason Simulation::checkCrash() {
+    // Check if the bike frame has hit the ground or the bike fell off the screen
+    if (frameGroundContacts > 0) {
+        return CrashReason::FrameHitGround;
+    }
+    if (bike.getPosition().y * SCALE > FALL_LIMIT_Y) {
+        return CrashReason::FellOffScreen;
+    }
+    return CrashReason::None;
+}
+
+const char* crashReasonName(CrashReason reason) {
+    switch (reason) {
+        case CrashReason::FrameHitGround:
+            return "Bike frame hit ground";
+        case CrashReason::FellOffScreen:
+            return "Bike fell off screen";
+        default:
+            return "None";
+    }
+}
+
+void addScriptedGhosts(Simulation& sim, unsigned count, uint32_t seed) {
+    // Each ghost gets its own hold/release rhythm, from the same ranges as the batch sweep
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<unsigned long> hold(10, 60);
+    std::uniform_int_distribution<unsigned long> release(0, 40);
+    for (unsigned i = 0; i < count; ++i) {
+        unsigned long holdSteps = hold(gen);
+        unsigned long releaseSteps = release(gen);
+        sim.addGhost(std::unique_ptr<InputSource>(new ScriptedInput(holdSteps, releaseSteps)));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Bicycle.h"
+#include "ContactListener.h"
+#include "InputSource.h"
+#include "Terrain.h"
+#include "WorldSnapshot.h"
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+const float PHYSICS_TIMESTEP = 1.0f / 60.0f;
+// Downwards, in m/s^2
+const float GRAVITY = 9.8f;
+const int VELOCITY_ITERATIONS = 8;
+const int POSITION_ITERATIONS = 3;
+// Most physics steps run back to back to catch up after a stall before the backlog is dropped
+const int MAX_STEPS_PER_FRAME = 5;
+// The run is lost once the bike drops below the bottom of the screen
+const float FALL_LIMIT_Y = 700.0f;
+// Once the player is this many chunks from the world origin, the origin moves to
+// the chunk under them, so Box2D and SFML only ever see small coordinates
+const int ORIGIN_SHIFT_CHUNKS = 8;
+// A ghost this many chunks behind or ahead of the player is retired as if it had
+// crashed, so a stuck ghost can't keep a growing stretch of terrain attached
+const int GHOST_MAX_DISTANCE_CHUNKS = 4;
+
+enum class CrashReason {
+    None,
+    FrameHitGround,
+    FellOffScreen
+};
+
+// A rider sharing the world with the player, driven by its own input. Bikes
+// don't collide with each other; a crashed ghost, or one that has strayed
+// too far from the player, is disabled until reset.
+struct Ghost {
+    std::unique_ptr<Bicycle> bike;
+    std::unique_ptr<InputSource> input;
+    bool crashed = false;
+    int frameGroundContacts = 0;
+};
+
+// The physics side of a run: world, bike, terrain and score.
+// Has no window, font or keyboard dependency so it can run headless.
+class Simulation {
+public:
+    // All terrain generation is driven by the seed, so a seed and the
+    // per-step input fully determine a run
+    // asyncTerrain pre-generates terrain on a worker thread (see Terrain)
+    Simulation(uint32_t seed, const BikeParams& params = BikeParams(), bool asyncTerrain = false);
+    void reset();
+    // Like reset(), but the next run rides the terrain of another seed
+    void reset(uint32_t newSeed);
+    // Advances one fixed step; returns true if a full rotation was scored
+    bool step(bool spacePressed);
+    CrashReason checkCrash();
+    bool isWheelOnGround() const { return wheelGroundContacts > 0; }
+    // The Space state the last step was given
+    bool wasSpacePressed() const { return lastSpacePressed; }
+    // Copies the run's state into out without allocating once out has a slot per ghost
+    void saveSnapshot(WorldSnapshot& out) const;
+    // Puts bikes, score, step count and origin back as saved; only attaches
+    // terrain if the window does not already cover every restored rider
+    void restoreSnapshot(const WorldSnapshot& snapshot);
+    // Adds a ghost at the start line; input is asked with the shared step count
+    void addGhost(std::unique_ptr<InputSource> input, const BikeParams& params = BikeParams());
+    std::vector<Ghost>& getGhosts() { return ghosts; }
+
+    Bicycle& getBike() { return bike; }
+    Terrain& getTerrain() { return terrain; }
+    int getScore() const { return score; }
+    unsigned long getStepCount() const { return stepCount; }
+    uint32_t getSeed() const { return seed; }
+    // Horizontal distance from the start position, in meters, across origin shifts
+    double getDistance() const;
+    // World x of the track's true start, in pixels; moves back as the origin follows the player
+    double getOriginX() const { return static_cast<double>(terrain.getOriginChunk()) * SEGMENT_LENGTH; }
+    unsigned long getOriginShifts() const { return originShifts; }
+
+private:
+    // Declared before the world so it outlives every callback the world makes
+    ContactListener contacts;
+    b2World world;
+    uint32_t seed;
+    Bicycle bike;
+    Terrain terrain;
+    int score = 0;
+    unsigned long stepCount = 0;
+    unsigned long originShifts = 0;
+    bool lastSpacePressed = false;
+    // Bike fixtures currently touching the ground, kept up to date from contact events
+    int frameGroundContacts = 0;
+    int wheelGroundContacts = 0;
+    std::vector<Ghost> ghosts;
+
+    void shiftOrigin(int chunkCount);
+    // World x of the leading and the last live rider, in pixels
+    void riderSpan(float& frontX, float& backX) const;
+    void consumeContactEvents();
+    // Rebuilds the ground contact counts from the bodies, after events were lost
+    void recountContacts();
+    void retireCrashedGhosts();
+};
+
+const char* crashReasonName(CrashReason reason);
+// Adds count ghosts with randomized scripted input, reproducible from seed
+void addScriptedGhosts(Simulation& sim, unsigned count, uint32_t seed);
+
+#endif // SIMULATION_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "SimulationThread.h"
+#include "Profiler.h"
+
+namespace {
+// While crashed, how often the thread checks for a restart
+const std::chrono::milliseconds IDLE_POLL(5);
+// Rewind history: one snapshot every SNAPSHOT_INTERVAL_STEPS, REWIND_SECONDS deep
+const unsigned long SNAPSHOT_INTERVAL_STEPS = 6;
+const float REWIND_SECONDS = 5.0f;
+const size_t REWIND_SNAPSHOTS = static_cast<size_t>(REWIND_SECONDS / (PHYSICS_TIMESTEP * SNAPSHOT_INTERVAL_STEPS));
+// Rewinding restores one snapshot every this many ticks, playing back at
+// SNAPSHOT_INTERVAL_STEPS / REWIND_TICKS_PER_SNAPSHOT times real speed
+const unsigned REWIND_TICKS_PER_SNAPSHOT = 2;
+
+RiderSnapshot riderSnapshot(const Bicycle& bike) {
+    RiderSnapshot rider;
+    b2Vec2 previous = bike.getPreviousPosition();
+    b2Vec2 current = bike.getPosition();
+    rider.previous = RiderPose{previous.x * SCALE, previous.y * SCALE, bike.getPreviousAngle()};
+    rider.current = RiderPose{current.x * SCALE, current.y * SCALE, bike.getBody()->GetAngle()};
+    return rider;
+}
+}
+
+RiderPose interpolate(const RiderSnapshot& rider, float alpha) {
+    const RiderPose& a = rider.previous;
+    const RiderPose& b = rider.current;
+    return RiderPose{a.x + alpha * (b.x - a.x), a.y + alpha * (b.y - a.y), a.angle + alpha * (b.angle - a.angle)};
+}
+
+void captureSnapshot(Simulation& sim, RenderSnapshot& snapshot) {
+    // The ghost count never changes, so reserving it is a no-op after the first call
+    snapshot.step = sim.getStepCount();
+    snapshot.steppedAt = std::chrono::steady_clock::now();
+    snapshot.player = riderSnapshot(sim.getBike());
+    sim.getBike().saveState(snapshot.playerState);
+    snapshot.spacePressed = sim.wasSpacePressed();
+    snapshot.wheelOnGround = sim.isWheelOnGround();
+    snapshot.ghosts.clear();
+    snapshot.ghosts.reserve(sim.getGhosts().size());
+    for (const Ghost& ghost : sim.getGhosts()) {
+        if (!ghost.crashed) {
+            snapshot.ghosts.push_back(riderSnapshot(*ghost.bike));
+        }
+    }
+    sim.getTerrain().getChunkHandles(snapshot.chunks);
+    snapshot.originChunk = sim.getTerrain().getOriginChunk();
+    snapshot.score = sim.getScore();
+}
+
+SimulationThread::SimulationThread(InputSource& input, uint32_t seed, unsigned ghostCount)
+    : input(input)
+    , sim(seed, BikeParams(), true)
+    , history(REWIND_SNAPSHOTS, ghostCount)
+{
+    addScriptedGhosts(sim, ghostCount, seed);
+    startCheckpoint.ghosts.resize(ghostCount);
+    sim.saveSnapshot(startCheckpoint);
+    // The renderer has a snapshot to draw before the first step
+    publish(CrashReason::None);
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    running = true;
+    thread = std::thread(&SimulationThread::loop, this);
+}
+
+void SimulationThread::stop() {
+    if (thread.joinable()) {
+        running = false;
+        thread.join();
+    }
+}
+
+void SimulationThread::restart() {
+    restartRequested.store(true, std::memory_order_release);
+}
+
+void SimulationThread::setRewinding(bool held) {
+    rewinding.store(held, std::memory_order_release);
+}
+
+const RenderSnapshot& SimulationThread::latest() {
+    snapshots.update();
+    return snapshots.front();
+}
+
+void SimulationThread::loop() {
+    // Fixed steps paced by the wall clock; the thread sleeps until each one is due
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration stepDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(PHYSICS_TIMESTEP));
+    Clock::time_point next = Clock::now();
+    CrashReason crash = CrashReason::None;
+    unsigned rewindTicks = 0;
+#ifdef TRACK_ALLOCATIONS
+    stepAllocations.begin();
+#endif
+
+    while (running.load(std::memory_order_relaxed)) {
+        if (restartRequested.exchange(false, std::memory_order_acquire)) {
+            sim.restoreSnapshot(startCheckpoint);
+            history.clear();
+            input.discardUntil(Clock::now());
+            run++;
+            crash = CrashReason::None;
+            publish(crash);
+            next = Clock::now();
+        }
+        if (rewinding.load(std::memory_order_acquire)) {
+            // Paced like steps; leaving a crash starts a new run so it is reported afresh.
+            // Once the ring is drained the world holds at its oldest snapshot until R
+            // is released, rather than stepping forward and saving new history.
+            std::this_thread::sleep_until(next);
+            next += stepDuration;
+            input.discardUntil(Clock::now());
+            if (!history.empty() && ++rewindTicks % REWIND_TICKS_PER_SNAPSHOT == 0) {
+                sim.restoreSnapshot(history.newest());
+                history.pop();
+                if (crash != CrashReason::None) {
+                    crash = CrashReason::None;
+                    run++;
+                }
+                publish(crash);
+            }
+            continue;
+        }
+        if (crash != CrashReason::None) {
+            // Presses on the game-over screen must not fire on the restarted run
+            input.discardUntil(Clock::now());
+            std::this_thread::sleep_for(IDLE_POLL);
+            next = Clock::now();
+            continue;
+        }
+
+        std::this_thread::sleep_until(next);
+        // Input is taken in as late as possible; events up to half a step past the
+        // step's due time are nearer to it than to the next one
+        input.advanceTo(next + stepDuration / 2);
+        next += stepDuration;
+        // After a long stall, drop the backlog instead of spiralling
+        if (Clock::now() - next > MAX_STEPS_PER_FRAME * stepDuration) {
+            next = Clock::now();
+        }
+        {
+            PROFILE_SCOPE(UpdatePhysics);
+            sim.step(input.isSpacePressed(sim.getStepCount()));
+        }
+        {
+            PROFILE_SCOPE(CheckGameOver);
+            crash = sim.checkCrash();
+        }
+        if (crash == CrashReason::None && sim.getStepCount() % SNAPSHOT_INTERVAL_STEPS == 0) {
+            sim.saveSnapshot(history.next());
+            history.push();
+        }
+        publish(crash);
+#ifdef TRACK_ALLOCATIONS
+        stepAllocations.endFrame();
+#endif
+    }
+}
+
+void SimulationThread::publish(CrashReason crash) {
+    // Fill the back slot in place; its vectors keep their capacity from earlier snapshots
+    RenderSnapshot& snapshot = snapshots.back();
+    captureSnapshot(sim, snapshot);
+    snapshot.run = run;
+    snapshot.crash = crash;
+    snapshot.lastPressAt = input.getLastPressTime();
+    snapshots.publish();
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "AllocationTracker.h"
+#include "InputSource.h"
+#include "Simulation.h"
+#include "TripleBuffer.h"
+#include "WorldSnapshot.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// A bike's transform in pixels and radians
+struct RiderPose {
+    float x = 0.0f;
+    float y = 0.0f;
+    float angle = 0.0f;
+};
+
+// A bike before and after the last physics step, so the renderer can blend them
+struct RiderSnapshot {
+    RiderPose previous;
+    RiderPose current;
+};
+
+RiderPose interpolate(const RiderSnapshot& rider, float alpha);
+
+// Everything the renderer needs from one physics step. Terrain chunks are
+// shared handles, so the simulation can evict them while a frame still draws them.
+struct RenderSnapshot {
+    // Counts restarts, so a crash is reported once per run
+    unsigned run = 0;
+    unsigned long step = 0;
+    std::chrono::steady_clock::time_point steppedAt;
+    RiderSnapshot player;
+    // Ghosts that have not crashed
+    std::vector<RiderSnapshot> ghosts;
+    std::vector<ChunkHandle> chunks;
+    // Poses and chunks are relative to this floating origin (see Terrain)
+    int originChunk = 0;
+    int score = 0;
+    CrashReason crash = CrashReason::None;
+    // The player's full body state and the input of the last step, for LandingPredictor
+    BikeState playerState;
+    bool spacePressed = false;
+    bool wheelOnGround = false;
+    // Stamp of the newest Space press applied by this step, for press-to-present latency
+    InputClock::time_point lastPressAt;
+};
+
+// Fills snapshot from the simulation's current state, reusing the storage of its
+// vectors; run and crash are left to the caller
+void captureSnapshot(Simulation& sim, RenderSnapshot& snapshot);
+
+// Steps a Simulation on its own thread at PHYSICS_TIMESTEP, whatever the frame
+// rate. After every step it publishes a RenderSnapshot through a triple buffer,
+// which the render thread reads without locks. Input is read from the
+// InputSource on this thread, which applies the events due by each step just
+// before it runs. After a crash it idles until restart().
+//
+// Every SNAPSHOT_INTERVAL_STEPS it also saves a WorldSnapshot into a fixed
+// ring covering the last REWIND_SECONDS. While rewinding is held it plays
+// that ring backwards instead of stepping, which also undoes a crash.
+// Restart restores a checkpoint taken at the start line rather than
+// rebuilding the world.
+class SimulationThread {
+public:
+    SimulationThread(InputSource& input, uint32_t seed, unsigned ghostCount);
+    ~SimulationThread();
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    void stop();
+    // Resets the run on the simulation thread before its next step
+    void restart();
+    // Hold to play the recent past backwards; release to carry on from there
+    void setRewinding(bool rewinding);
+    // Render thread: swaps in the newest published snapshot, if any, and returns it
+    const RenderSnapshot& latest();
+#ifdef TRACK_ALLOCATIONS
+    // Heap use per physics step; read after stop()
+    const AllocationMeter& getStepAllocations() const { return stepAllocations; }
+#endif
+
+private:
+    InputSource& input;
+    Simulation sim;
+    unsigned run = 0;
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> restartRequested{false};
+    std::atomic<bool> rewinding{false};
+    SnapshotRing history;
+    WorldSnapshot startCheckpoint;
+#ifdef TRACK_ALLOCATIONS
+    AllocationMeter stepAllocations;
+#endif
+
+    void loop();
+    void publish(CrashReason crash);
+};
+
+#endif // SIMULATIONTHREAD_H
\ No newline at end of file
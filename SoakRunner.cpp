@@ -0,0 +1,129 @@
+#include "SoakRunner.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+struct SoakWindow {
+    unsigned long steps = 0;
+    long residentKb = 0;
+    double meanStepUs = 0.0;
+    double maxStepUs = 0.0;
+    // Meters travelled forward, summed over every run in the window
+    double progress = 0.0;
+    unsigned long crashes = 0;
+    // Largest |x| the player reached in world coordinates, in pixels
+    float maxWorldX = 0.0f;
+};
+
+long residentKb() {
+    // /proc/self/statm holds the total and resident sizes in pages, first and second
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    if (!(statm >> size >> resident)) {
+        return -1;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+}
+
+bool runSoakTest(InputSource& input, uint32_t seed, double hours) {
+    using Clock = std::chrono::steady_clock;
+    const unsigned long windowSteps = static_cast<unsigned long>(SOAK_WINDOW_MINUTES * 60.0 / PHYSICS_TIMESTEP);
+    const unsigned long totalSteps = static_cast<unsigned long>(hours * 3600.0 / PHYSICS_TIMESTEP);
+    Simulation sim(seed, BikeParams(), true);
+    std::vector<SoakWindow> windows;
+    unsigned long done = 0;
+    // Input is a pure function of the step, so each run after a crash gets terrain from
+    // the next seed; otherwise the whole soak would replay the first run over and over
+    uint32_t runSeed = seed;
+    double lastDistance = sim.getDistance();
+
+    std::cout << "Soak: " << hours << " h simulated in " << SOAK_WINDOW_MINUTES << " min windows\n"
+              << "   sim min      RSS KB   step us    max us   m/min  crashes  max |x| px" << std::endl;
+    while (done < totalSteps) {
+        SoakWindow window;
+        double totalUs = 0.0;
+        for (; window.steps < windowSteps && done < totalSteps; ++window.steps, ++done) {
+            auto start = Clock::now();
+            sim.step(input.isSpacePressed(sim.getStepCount()));
+            CrashReason crash = sim.checkCrash();
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            totalUs += us;
+            window.maxStepUs = std::max(window.maxStepUs, us);
+            window.maxWorldX = std::max(window.maxWorldX, std::abs(sim.getBike().getPosition().x * SCALE));
+            double distance = sim.getDistance();
+            window.progress += distance - lastDistance;
+            lastDistance = distance;
+            if (crash != CrashReason::None) {
+                sim.reset(++runSeed);
+                window.crashes++;
+                lastDistance = sim.getDistance();
+            }
+        }
+        window.meanStepUs = totalUs / window.steps;
+        window.residentKb = residentKb();
+        windows.push_back(window);
+
+        double minutes = window.steps * PHYSICS_TIMESTEP / 60.0;
+        std::cout << std::fixed << std::setprecision(1) << std::setw(10) << done * PHYSICS_TIMESTEP / 60.0
+                  << std::setw(12) << window.residentKb << std::setw(10) << window.meanStepUs
+                  << std::setw(10) << window.maxStepUs << std::setw(8) << window.progress / minutes
+                  << std::setw(9) << window.crashes << std::setw(12) << window.maxWorldX << std::endl;
+    }
+    if (windows.empty()) {
+        return true;
+    }
+
+    // The first window includes warm-up (page faults, caches, the first chunks), so
+    // compare against the second when there is one
+    const SoakWindow& baseline = windows.size() > 2 ? windows[1] : windows[0];
+    const SoakWindow& last = windows.back();
+    bool ok = true;
+
+    long rssGrowth = last.residentKb - baseline.residentKb;
+    if (baseline.residentKb < 0) {
+        std::cout << "RSS:         not available on this system" << std::endl;
+    } else {
+        bool pass = rssGrowth <= SOAK_RSS_GROWTH_KB;
+        ok = ok && pass;
+        std::cout << "RSS:         " << std::showpos << rssGrowth << std::noshowpos << " KB (limit "
+                  << SOAK_RSS_GROWTH_KB << ") " << (pass ? "OK" : "FAILED") << std::endl;
+    }
+
+    double stepGrowth = last.meanStepUs / baseline.meanStepUs;
+    bool stepPass = stepGrowth <= SOAK_STEP_TIME_GROWTH;
+    ok = ok && stepPass;
+    std::cout << std::setprecision(2) << "Step time:   x" << stepGrowth << " (limit x" << SOAK_STEP_TIME_GROWTH
+              << ") " << (stepPass ? "OK" : "FAILED") << std::endl;
+
+    double baselineRate = baseline.progress / baseline.steps;
+    double lastRate = last.progress / last.steps;
+    bool progressPass = baselineRate <= 0.0 || std::abs(lastRate - baselineRate) <= SOAK_PROGRESS_TOLERANCE * baselineRate;
+    ok = ok && progressPass;
+    std::cout << "Progress:    x" << (baselineRate > 0.0 ? lastRate / baselineRate : 0.0) << " of the baseline rate (tolerance "
+              << SOAK_PROGRESS_TOLERANCE * 100.0 << "%) " << (progressPass ? "OK" : "FAILED") << std::endl;
+
+    // With the floating origin the player never gets further than a chunk past the shift point
+    float xLimit = (ORIGIN_SHIFT_CHUNKS + 1) * SEGMENT_LENGTH;
+    float maxWorldX = 0.0f;
+    for (const SoakWindow& window : windows) {
+        maxWorldX = std::max(maxWorldX, window.maxWorldX);
+    }
+    // A soak whose runs all crash before the first shift never exercised the origin at all
+    bool originPass = maxWorldX <= xLimit && sim.getOriginShifts() > 0;
+    ok = ok && originPass;
+    std::cout << std::setprecision(0) << "World x:     max " << maxWorldX << " px (limit " << xLimit << "), "
+              << sim.getOriginShifts() << " origin shifts over " << runSeed - seed + 1 << " runs "
+              << (originPass ? "OK" : "FAILED") << std::endl;
+
+    std::cout << "Soak " << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef SOAKRUNNER_H
+#define SOAKRUNNER_H
+
+#include "InputSource.h"
+#include <cstdint>
+
+// Simulated minutes per report window
+const double SOAK_WINDOW_MINUTES = 10.0;
+// Limits for the last window against the first one after warm-up
+const long SOAK_RSS_GROWTH_KB = 4096;
+const double SOAK_STEP_TIME_GROWTH = 1.5;
+const double SOAK_PROGRESS_TOLERANCE = 0.25;
+
+// Simulates hours of riding headless, restarting on the terrain of the next
+// seed (seed, seed + 1, ...) after every crash, and checks that nothing
+// drifts with time or distance: resident memory doesn't grow, steps don't
+// get slower, the bike covers ground at the same rate and the floating
+// origin keeps world coordinates small, having shifted at least once.
+// Prints one line per window; returns false if a check fails.
+bool runSoakTest(InputSource& input, uint32_t seed, double hours);
+
+#endif // SOAKRUNNER_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    // Moves value in only if there is room
+    bool tryPush(T& value) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[tail % Capacity] = std::move(value);
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots[head % Capacity]);
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only safe while neither side is running. Also resets the slots, so values
+    // left in them (shared chunks, say) are released now rather than when overwritten
+    void clear() {
+        slots.fill(T());
+        headIndex.store(0, std::memory_order_relaxed);
+        tailIndex.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<T, Capacity> slots;
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+};
+
+#endif // SPSCQUEUE_H
\ No newline at end of file
@@ -1,110 +1,219 @@
 #include "Terrain.h"
 #include "Bicycle.h"
+#include "ContactListener.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <utility>
 
-Terrain::Terrain(b2World* world) : endX(3000.0f), baseY(350.0f) {
-    float startX = 0.0f;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 2);
+Terrain::Terrain(b2World* world, uint32_t seed, bool asyncGeneration)
+    : world(world)
+    , endX(0.0f)
+    , generator(seed)
+    , cache(CACHED_CHUNKS)
+    , asyncGeneration(asyncGeneration)
+{
+    // Each chunk gets its own ground body when it is attached
+    chunks.reserve(ATTACHED_CHUNKS_RESERVED);
+    // A chain has at most one vertex per sample
+    chainVertices.reserve(CHUNK_SAMPLES);
 
     // Generate initial terrain segments
-    for (float x = startX; x < endX; x += SEGMENT_LENGTH) {
-        int pathType = dis(gen);
-        auto segmentPoints = generatePath(x, x + SEGMENT_LENGTH, 30.0f, pathType, baseY);
-        for (const auto& p : segmentPoints) {
-            points.push_back(p);
-            terrainVisual.emplace_back(sf::Vector2f(p.x * SCALE, p.y * SCALE), sf::Color::Green);
-        }
+    jumpTo(0.0f);
+}
+
+Terrain::~Terrain() {
+    stopWorker();
+}
+
+void Terrain::jumpTo(float frontX, float backX) {
+    // Nothing to do if the window already covers the riders with the usual margins
+    int first = std::max(0, static_cast<int>(std::floor((backX - EVICT_DISTANCE) / SEGMENT_LENGTH)) + originChunk);
+    if (!chunks.empty() && chunks.front().chunk->index <= first && frontX < endX - GENERATE_THRESHOLD) {
+        return;
+    }
+
+    // Detach everything into the cache and attach the chunks around x
+    stopWorker();
+    while (!chunks.empty()) {
+        detachFront();
+    }
+    for (int index = first; index < first + INITIAL_CHUNKS || endX <= frontX + GENERATE_THRESHOLD; ++index) {
+        attachChunk(takeChunk(index));
     }
+    startWorker(chunks.back().chunk->index + 1);
+}
 
-    // Create the Box2D ground body and attach the terrain shape
-    b2BodyDef groundDef;
-    ground = world->CreateBody(&groundDef);
-    if (!points.empty()) {
-        b2ChainShape chain;
-        chain.CreateChain(points.data(), static_cast<int32>(points.size()), b2Vec2(0.0f, 0.0f), b2Vec2(0.0f, 0.0f));
-        ground->CreateFixture(&chain, 0.0f);
+void Terrain::reseed(uint32_t seed) {
+    stopWorker();
+    while (!chunks.empty()) {
+        detachFront();
     }
+    cache.clear();
+    generator = TerrainGenerator(seed);
+    jumpTo(0.0f);
 }
 
-std::vector<b2Vec2> Terrain::generatePath(float startX, float endX, float step, int pathType, float startY) {
-    // Generate a vector of points for a terrain segment based on the path type
-    std::vector<b2Vec2> points;
-    for (float x = startX; x <= endX; x += step) {
-        float y;
-        switch (pathType) {
-            case 0: // Wavy path
-                y = startY + 50.0f * std::sin((x - startX) * 0.006f);
-                break;
-            case 1: // Hilly path
-                y = startY + 80.0f * std::cos((x - startX) * 0.004f);
-                break;
-            case 2: // Steep waves
-                y = startY + 100.0f * std::sin((x - startX) * 0.008f);
-                break;
-            default:
-                y = startY;
+b2Body* createChunkBody(b2World* world, const TerrainChunk& chunk, float startX, std::vector<b2Vec2>& vertices) {
+    // Box2D copies the vertices, so the scratch buffer is free again once this returns
+    vertices.resize(chunk.vertices.size());
+    for (size_t k = 0; k < chunk.vertices.size(); ++k) {
+        vertices[k] = chunk.heights.vertex(chunk.vertices[k]);
+    }
+    b2ChainShape chain;
+    chain.CreateChain(vertices.data(), static_cast<int32>(vertices.size()), chunk.prevGhost, chunk.nextGhost);
+    b2BodyDef bodyDef;
+    bodyDef.position.Set(startX / SCALE, 0.0f);
+    b2Body* body = world->CreateBody(&bodyDef);
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &chain;
+    fixtureDef.filter.categoryBits = GROUND_COLLISION_BITS;
+    fixtureDef.userData.pointer = static_cast<uintptr_t>(FixtureCategory::Ground);
+    body->CreateFixture(&fixtureDef);
+    return body;
+}
+
+void Terrain::attachChunk(ChunkHandle chunk, bool atFront) {
+    // The only Box2D work left for the calling thread: a static body at the chunk's start
+    b2Body* body = createChunkBody(world, *chunk, chunkStartX(chunk->index), chainVertices);
+    if (atFront) {
+        chunks.insert(chunks.begin(), AttachedChunk{std::move(chunk), body});
+    } else {
+        endX = chunkStartX(chunk->index + 1);
+        chunks.push_back(AttachedChunk{std::move(chunk), body});
+    }
+}
+
+void Terrain::detachFront() {
+    // Destroy the body but keep the heights around in case the riders come back
+    world->DestroyBody(chunks.front().body);
+    cache.put(std::move(chunks.front().chunk));
+    chunks.erase(chunks.begin());
+    if (chunks.empty()) {
+        endX = 0.0f;
+    }
+}
+
+void Terrain::detachBack() {
+    world->DestroyBody(chunks.back().body);
+    cache.put(std::move(chunks.back().chunk));
+    chunks.pop_back();
+    endX = chunks.empty() ? 0.0f : chunkStartX(chunks.back().chunk->index + 1);
+}
+
+void Terrain::shiftOrigin(int chunkCount) {
+    // Bodies already moved with the world; only the mapping from index to x changes
+    originChunk += chunkCount;
+    endX -= chunkCount * SEGMENT_LENGTH;
+}
+
+ChunkHandle Terrain::takeChunk(int index) {
+    // Cached ground first, then the worker if it is generating this far, else build it here
+    ChunkHandle chunk;
+    if (cache.take(index, chunk)) {
+        return chunk;
+    }
+    if (worker.joinable() && index >= workerFirstIndex) {
+        // This spin-waits on the simulation thread until the worker delivers index. The worker
+        // stays several chunks ahead, so it only spins if the worker has fallen behind, and
+        // never for longer than the worker takes to generate the chunks up to index. It
+        // produces consecutive indices; ones the window got elsewhere are cached, not thrown away
+        while (true) {
+            if (!ready.tryPop(chunk)) {
+                std::this_thread::yield();
+            } else if (chunk->index == index) {
+                return chunk;
+            } else if (chunk->index > index) {
+                cache.put(std::move(chunk));
                 break;
+            } else {
+                cache.put(std::move(chunk));
+            }
         }
-        points.emplace_back(x / SCALE, y / SCALE);
     }
-    return points;
+    return std::make_shared<const TerrainChunk>(generator.generate(index));
 }
 
-void Terrain::extendIfNeeded(float bikeX, std::mt19937& gen) {
-    // If the bike is near the end of the current terrain, generate more terrain
-    if (bikeX > endX - GENERATE_THRESHOLD) {
-        std::uniform_int_distribution<> dis(0, 2);
-        int pathType = dis(gen);
-        float startX = endX;
-        endX += SEGMENT_LENGTH;
+void Terrain::evictOutside(float frontX, float backX) {
+    // Drop chunks that are far behind the last rider or far ahead of the leader, always keeping one
+    while (chunks.size() > 1 && chunkStartX(chunks.front().chunk->index + 1) < backX - EVICT_DISTANCE) {
+        detachFront();
+    }
+    while (chunks.size() > 1 && chunkStartX(chunks.back().chunk->index) > frontX + EVICT_DISTANCE) {
+        detachBack();
+    }
+}
 
-        float lastY = points.empty() ? baseY : points.back().y * SCALE;
-        auto segmentPoints = generatePath(startX, endX, 30.0f, pathType, lastY);
+void Terrain::extendIfNeeded(float frontX, float backX) {
+    // If the leading bike is near the end of the current terrain, attach the next chunk
+    if (frontX > endX - GENERATE_THRESHOLD) {
+        attachChunk(takeChunk(chunks.back().chunk->index + 1));
+        evictOutside(frontX, backX);
+    }
+    // Evicted ground comes back when a rider returns to it
+    if (chunks.front().chunk->index > 0 && backX < chunkStartX(chunks.front().chunk->index) + GENERATE_THRESHOLD) {
+        attachChunk(takeChunk(chunks.front().chunk->index - 1), true);
+        evictOutside(frontX, backX);
+    }
+}
 
-        for (const auto& p : segmentPoints) {
-            points.push_back(p);
-            terrainVisual.emplace_back(sf::Vector2f(p.x * SCALE, p.y * SCALE), sf::Color::Green);
-        }
+void Terrain::startWorker(int firstIndex) {
+    if (!asyncGeneration) {
+        return;
+    }
+    ready.clear();
+    workerFirstIndex = firstIndex;
+    workerRunning = true;
+    worker = std::thread(&Terrain::workerLoop, this);
+}
+
+void Terrain::stopWorker() {
+    if (worker.joinable()) {
+        workerRunning = false;
+        worker.join();
+    }
+}
 
-        // Properly destroy all fixtures attached to the ground body
-        b2Fixture* fixture = ground->GetFixtureList();
-        while (fixture) {
-            b2Fixture* next = fixture->GetNext();
-            ground->DestroyFixture(fixture);
-            fixture = next;
+void Terrain::workerLoop() {
+    // Keep the queue topped up with the chunks after the window
+    ChunkHandle pending;
+    bool hasPending = false;
+    int nextIndex = workerFirstIndex;
+    while (workerRunning) {
+        if (!hasPending) {
+            pending = std::make_shared<const TerrainChunk>(generator.generate(nextIndex++));
+            hasPending = true;
         }
-        // Recreate the chain shape with the new points
-        if (!points.empty()) {
-            b2ChainShape chain;
-            chain.CreateChain(points.data(), static_cast<int32>(points.size()), b2Vec2(0.0f, 0.0f), b2Vec2(0.0f, 0.0f));
-            ground->CreateFixture(&chain, 0.0f);
+        if (ready.tryPush(pending)) {
+            hasPending = false;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
     }
 }
 
-void Terrain::render(sf::RenderWindow& window) {
-    // Render the terrain as a series of thick green lines
-    float lineThickness = 5.0f;
-    float step = 30.0f;
-    for (size_t i = 0; i < terrainVisual.size() - 1; ++i) {
-        sf::Vector2f p1 = terrainVisual[i].position;
-        sf::Vector2f p2 = terrainVisual[i+1].position;
-
-        sf::Vector2f direction_check = p2 - p1;
-        float distance_check = std::sqrt(direction_check.x * direction_check.x + direction_check.y * direction_check.y);
-        if (distance_check <= step * 1.5f) {
-            sf::Vector2f direction = p2 - p1;
-            float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-            float angle = std::atan2(direction.y, direction.x) * 180 / 3.14159265f;
-
-            sf::RectangleShape segment(sf::Vector2f(distance, lineThickness));
-            segment.setOrigin(0, lineThickness / 2.0f);
-            segment.setPosition(p1);
-            segment.setRotation(angle);
-            segment.setFillColor(sf::Color::Green);
-            window.draw(segment);
-        }
+const Terrain::AttachedChunk& Terrain::chunkAt(float x) const {
+    // Chunks are contiguous and equally long, so the one under x is found by division
+    float offset = (x - chunkStartX(chunks.front().chunk->index)) / SEGMENT_LENGTH;
+    size_t i = static_cast<size_t>(std::max(offset, 0.0f));
+    return chunks[std::min(i, chunks.size() - 1)];
+}
+
+float Terrain::heightAt(float x) const {
+    const AttachedChunk& attached = chunkAt(x);
+    return attached.chunk->heights.heightAt(x - chunkStartX(attached.chunk->index));
+}
+
+float Terrain::slopeAt(float x) const {
+    const AttachedChunk& attached = chunkAt(x);
+    return attached.chunk->heights.slopeAt(x - chunkStartX(attached.chunk->index));
+}
+
+void Terrain::getChunkHandles(std::vector<ChunkHandle>& out) const {
+    // Reserving what the window has room for keeps refills of the same vector allocation-free
+    out.clear();
+    out.reserve(chunks.capacity());
+    for (const AttachedChunk& attached : chunks) {
+        out.push_back(attached.chunk);
     }
 }
\ No newline at end of file
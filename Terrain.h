@@ -1,29 +1,102 @@
 #ifndef TERRAIN_H
 #define TERRAIN_H
 
-#include <SFML/Graphics.hpp>
+#include "ChunkCache.h"
+#include "SpscQueue.h"
+#include "TerrainGenerator.h"
 #include <box2d/box2d.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 #include <vector>
-#include <random>
 
-const float SEGMENT_LENGTH = 1000.0f;
 const float GENERATE_THRESHOLD = 500.0f;
+const float EVICT_DISTANCE = 2000.0f;
+const int INITIAL_CHUNKS = 3;
+// How many finished chunks the background generator keeps ready
+const size_t PREGENERATED_CHUNKS = 4;
+// Detached chunks kept for when the riders or a rewind come back to them
+const size_t CACHED_CHUNKS = 16;
+// Attached chunks the window holds before its storage has to grow
+const size_t ATTACHED_CHUNKS_RESERVED = 16;
 
+// The ground as a window of attached chunks around the riders. Chunks are a
+// pure function of (seed, index), so memory stays bounded however far the
+// riders go and any point of the track can be jumped to directly.
+//
+// World x is measured from a floating origin: chunk i starts at
+// (i - originChunk) * SEGMENT_LENGTH. Each attached chunk is its own static
+// body holding chunk-relative vertices, so b2World::ShiftOrigin moves the
+// ground with everything else and no coordinate grows with distance.
 class Terrain {
 public:
-    Terrain(b2World* world);
-    void extendIfNeeded(float bikeX, std::mt19937& gen);
-    void render(sf::RenderWindow& window);
-    b2Body* getBody() const { return ground; }
+    // With asyncGeneration, upcoming chunks are built on a worker thread and
+    // the main thread only attaches their fixtures
+    Terrain(b2World* world, uint32_t seed, bool asyncGeneration = false);
+    ~Terrain();
+    Terrain(const Terrain&) = delete;
+    Terrain& operator=(const Terrain&) = delete;
+
+    void reset() { jumpTo(0.0f); }
+    // Drops every chunk of the old seed, attached or cached, and loads the start of the new one
+    void reseed(uint32_t seed);
+    // Loads the window around world x, keeping chunks that are already attached
+    void jumpTo(float x) { jumpTo(x, x); }
+    // For several riders: the window from behind the last one to ahead of the leader
+    void jumpTo(float frontX, float backX);
+    // Call after b2World::ShiftOrigin by chunkCount * SEGMENT_LENGTH, which has already moved the bodies
+    void shiftOrigin(int chunkCount);
+    void extendIfNeeded(float bikeX) { extendIfNeeded(bikeX, bikeX); }
+    // For several riders: attach ahead of the leader and behind the last one as
+    // they approach either end, evict behind the last one
+    void extendIfNeeded(float frontX, float backX);
+    // The attached chunks in x order, for a TerrainRenderer on any thread
+    void getChunkHandles(std::vector<ChunkHandle>& out) const;
+    // Ground height and dy/dx at x in pixels, in O(1); clamped to the loaded terrain
+    float heightAt(float x) const;
+    float slopeAt(float x) const;
+    float getEndX() const { return endX; }
+    int getOriginChunk() const { return originChunk; }
+    // World x where chunk index starts
+    float chunkStartX(int index) const { return (index - originChunk) * SEGMENT_LENGTH; }
+    size_t getChunkCount() const { return chunks.size(); }
+    size_t getCachedChunkCount() const { return cache.size(); }
 
 private:
-    b2Body* ground;
-    std::vector<b2Vec2> points;
-    std::vector<sf::Vertex> terrainVisual;
+    b2World* world;
+    struct AttachedChunk {
+        ChunkHandle chunk;
+        b2Body* body;
+    };
+    // In x order; a handful of entries, so inserting at the front is cheap
+    std::vector<AttachedChunk> chunks;
     float endX;
-    float baseY;
+    int originChunk = 0;
+    // Reused while attaching a chunk
+    std::vector<b2Vec2> chainVertices;
+
+    TerrainGenerator generator;
+    ChunkCache cache;
+    bool asyncGeneration;
+    SpscQueue<ChunkHandle, PREGENERATED_CHUNKS> ready;
+    std::thread worker;
+    std::atomic<bool> workerRunning{false};
+    // First index the running worker generates; it produces consecutive chunks from here
+    int workerFirstIndex = 0;
 
-    std::vector<b2Vec2> generatePath(float startX, float endX, float step, int pathType, float startY);
+    void attachChunk(ChunkHandle chunk, bool atFront = false);
+    void detachFront();
+    void detachBack();
+    const AttachedChunk& chunkAt(float x) const;
+    ChunkHandle takeChunk(int index);
+    void evictOutside(float frontX, float backX);
+    void startWorker(int firstIndex);
+    void stopWorker();
+    void workerLoop();
 };
 
+// A static body at world x startX (pixels) with the chunk's ground as one chain
+// fixture; vertices is scratch space, reused between calls
+b2Body* createChunkBody(b2World* world, const TerrainChunk& chunk, float startX, std::vector<b2Vec2>& vertices);
+
 #endif // TERRAIN_H
\ No newline at end of file
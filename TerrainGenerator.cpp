@@ -0,0 +1,77 @@
+#include "TerrainGenerator.h"
+#include "Bicycle.h"
+#include "Profiler.h"
+#include <cmath>
+
+namespace {
+// splitmix64 finalizer over (seed, index, salt), so neighbouring indices are unrelated
+uint64_t hashChunk(uint32_t seed, int index, uint32_t salt) {
+    uint64_t x = (static_cast<uint64_t>(seed) << 32 | static_cast<uint32_t>(index)) ^ (static_cast<uint64_t>(salt) * 0x9E3779B97F4A7C15ull);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+const uint32_t SALT_PATH_TYPE = 1;
+const uint32_t SALT_BOUNDARY = 2;
+}
+
+TerrainGenerator::TerrainGenerator(uint32_t seed) : seed(seed) {
+}
+
+float TerrainGenerator::boundaryY(int index) const {
+    // The track always starts at the base height, under the spawn point
+    if (index == 0) {
+        return TERRAIN_BASE_Y;
+    }
+    float unit = (hashChunk(seed, index, SALT_BOUNDARY) >> 40) / static_cast<float>(1 << 24);
+    float y = TERRAIN_BASE_Y + (unit * 2.0f - 1.0f) * BOUNDARY_VARIATION;
+    // On the quantization grid, so seams stay exact with QUANTIZE_TERRAIN too
+    return std::round(y / HEIGHT_QUANTUM) * HEIGHT_QUANTUM;
+}
+
+PathShape TerrainGenerator::chunkShape(int index, float& startY, float& endY) const {
+    // Offset and tilt the wave so it passes through both boundary heights;
+    // fastSin is what the kernel uses, so the ends land where intended
+    PathShape shape = pathShape(static_cast<int>(hashChunk(seed, index, SALT_PATH_TYPE) % 3));
+    float first = boundaryY(index);
+    float last = boundaryY(index + 1);
+    float waveStart = shape.amplitude * fastSin(shape.phase);
+    float waveEnd = shape.amplitude * fastSin(shape.frequency * SEGMENT_LENGTH + shape.phase);
+    shape.slope = (last - first - (waveEnd - waveStart)) / SEGMENT_LENGTH;
+    startY = first;
+    endY = last;
+    return shape;
+}
+
+b2Vec2 TerrainGenerator::sampleVertex(int index, size_t sample, int relativeTo) const {
+    // One sample of another chunk, for ghost vertices, without building that chunk
+    float startY, endY;
+    PathShape shape = chunkShape(index, startY, endY);
+    float y;
+    generatePathHeights(&y, 1, startY - shape.amplitude * fastSin(shape.phase), sample * TERRAIN_STEP, TERRAIN_STEP, shape);
+    return b2Vec2(((index - relativeTo) * SEGMENT_LENGTH + sample * TERRAIN_STEP) / SCALE, y / SCALE);
+}
+
+TerrainChunk TerrainGenerator::generate(int index) const {
+    PROFILE_SCOPE(TerrainGenerate);
+    float startY, endY;
+    PathShape shape = chunkShape(index, startY, endY);
+
+    // Scratch per thread, as the worker and the main thread may both generate
+    thread_local std::vector<float> heights;
+    heights.resize(CHUNK_SAMPLES);
+    generatePathHeights(heights.data(), CHUNK_SAMPLES, startY - shape.amplitude * fastSin(shape.phase), 0.0f, TERRAIN_STEP, shape);
+    // Pin both ends so neighbouring chunks share their seam sample bit for bit
+    heights.front() = startY;
+    heights.back() = endY;
+
+    TerrainChunk chunk;
+    chunk.index = index;
+    chunk.heights = Heightfield(0.0f, TERRAIN_STEP, heights.data(), CHUNK_SAMPLES);
+    // The two samples at each end are always vertices, so these ghosts match the neighbours exactly
+    chunk.heights.selectVertices(TERRAIN_TOLERANCE, chunk.vertices);
+    chunk.prevGhost = sampleVertex(index - 1, CHUNK_SAMPLES - 2, index);
+    chunk.nextGhost = sampleVertex(index + 1, 1, index);
+    return chunk;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef TERRAINGENERATOR_H
+#define TERRAINGENERATOR_H
+
+#include "Heightfield.h"
+#include "TerrainKernel.h"
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+const float SEGMENT_LENGTH = 1000.0f;
+// Horizontal distance between terrain samples, in pixels
+const float TERRAIN_STEP = 5.0f;
+// Samples per chunk, both ends included
+const size_t CHUNK_SAMPLES = static_cast<size_t>(SEGMENT_LENGTH / TERRAIN_STEP) + 1;
+const float TERRAIN_BASE_Y = 350.0f;
+const float TERRAIN_LINE_THICKNESS = 5.0f;
+// Largest distance, in pixels, the chain and ground strip may stray from the sampled curve
+const float TERRAIN_TOLERANCE = 0.25f;
+
+// One SEGMENT_LENGTH slice of the ground, attached as its own chain fixture.
+// The first sample of a chunk is shared with the last sample of the previous one.
+// x is relative to the chunk's own start, so coordinates stay small however far
+// along the track it lies; Terrain places it in the world.
+struct TerrainChunk {
+    int index = 0;
+    // Starts at x = 0
+    Heightfield heights;
+    // Samples used as chain and ground strip vertices, in x order (see Heightfield::selectVertices)
+    std::vector<uint16_t> vertices;
+    // Neighbouring vertices outside the chunk, so wheels don't catch on seams; chunk-relative
+    b2Vec2 prevGhost;
+    b2Vec2 nextGhost;
+};
+
+// Chunks never change once generated, so threads share them through these
+typedef std::shared_ptr<const TerrainChunk> ChunkHandle;
+
+// Largest distance a chunk boundary may sit above or below TERRAIN_BASE_Y, in pixels
+const float BOUNDARY_VARIATION = 60.0f;
+
+// Makes chunks as a pure function of (seed, index): the same pair always gives
+// the same ground, so any chunk can be built on its own, in any order, at any
+// time. Chunk boundaries get a height from the hash of their index; each
+// chunk's wave is tilted so it starts and ends exactly on its two boundaries.
+// Touches no Box2D world and keeps no state, so it can run on any thread.
+class TerrainGenerator {
+public:
+    TerrainGenerator(uint32_t seed);
+    TerrainChunk generate(int index) const;
+    uint32_t getSeed() const { return seed; }
+
+private:
+    uint32_t seed;
+
+    float boundaryY(int index) const;
+    // Wave of a chunk with its incline, plus the exact heights of its two ends
+    PathShape chunkShape(int index, float& startY, float& endY) const;
+    // A sample of chunk index, relative to the start of chunk relativeTo
+    b2Vec2 sampleVertex(int index, size_t sample, int relativeTo) const;
+};
+
+#endif // TERRAINGENERATOR_H
\ No newline at end of file
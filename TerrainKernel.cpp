@@ -0,0 +1,148 @@
+#include "TerrainKernel.h"
+#include <cmath>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+const float PI_F = 3.14159265358979f;
+const float HALF_PI_F = 1.57079632679490f;
+const float INV_TWO_PI = 0.159154943091895f;
+// 2*pi split in two so the range reduction keeps its precision
+const float TWO_PI_HI = 6.28125f;
+const float TWO_PI_LO = 1.93530717958648e-3f;
+// Taylor coefficients of sin on [-pi/2, pi/2]
+const float S3 = -1.0f / 6.0f;
+const float S5 = 1.0f / 120.0f;
+const float S7 = -1.0f / 5040.0f;
+const float S9 = 1.0f / 362880.0f;
+
+#if defined(__AVX__)
+inline __m256 fastSin8(__m256 x) {
+    __m256 k = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(INV_TWO_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_sub_ps(x, _mm256_mul_ps(k, _mm256_set1_ps(TWO_PI_HI)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(k, _mm256_set1_ps(TWO_PI_LO)));
+
+    __m256 pi = _mm256_set1_ps(PI_F);
+    __m256 halfPi = _mm256_set1_ps(HALF_PI_F);
+    x = _mm256_blendv_ps(x, _mm256_sub_ps(pi, x), _mm256_cmp_ps(x, halfPi, _CMP_GT_OQ));
+    __m256 negHalfPi = _mm256_sub_ps(_mm256_setzero_ps(), halfPi);
+    x = _mm256_blendv_ps(x, _mm256_sub_ps(_mm256_sub_ps(_mm256_setzero_ps(), pi), x), _mm256_cmp_ps(x, negHalfPi, _CMP_LT_OQ));
+
+    __m256 x2 = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_add_ps(_mm256_set1_ps(S7), _mm256_mul_ps(x2, _mm256_set1_ps(S9)));
+    p = _mm256_add_ps(_mm256_set1_ps(S5), _mm256_mul_ps(x2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(S3), _mm256_mul_ps(x2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(x2, p));
+    return _mm256_mul_ps(x, p);
+}
+#elif defined(__SSE2__)
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 fastSin4(__m128 x) {
+    __m128 k = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_TWO_PI))));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TWO_PI_HI)));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TWO_PI_LO)));
+
+    __m128 pi = _mm_set1_ps(PI_F);
+    __m128 halfPi = _mm_set1_ps(HALF_PI_F);
+    x = select4(_mm_cmpgt_ps(x, halfPi), _mm_sub_ps(pi, x), x);
+    __m128 negHalfPi = _mm_sub_ps(_mm_setzero_ps(), halfPi);
+    x = select4(_mm_cmplt_ps(x, negHalfPi), _mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), pi), x), x);
+
+    __m128 x2 = _mm_mul_ps(x, x);
+    __m128 p = _mm_add_ps(_mm_set1_ps(S7), _mm_mul_ps(x2, _mm_set1_ps(S9)));
+    p = _mm_add_ps(_mm_set1_ps(S5), _mm_mul_ps(x2, p));
+    p = _mm_add_ps(_mm_set1_ps(S3), _mm_mul_ps(x2, p));
+    p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x2, p));
+    return _mm_mul_ps(x, p);
+}
+#endif
+}
+
+PathShape pathShape(int pathType) {
+    switch (pathType) {
+        case 0: // Wavy path
+            return {50.0f, 0.006f, 0.0f};
+        case 1: // Hilly path (cosine)
+            return {80.0f, 0.004f, HALF_PI_F};
+        case 2: // Steep waves
+            return {100.0f, 0.008f, 0.0f};
+        default: // Flat
+            return {0.0f, 0.0f, 0.0f};
+    }
+}
+
+float fastSin(float x) {
+    // Reduce to [-pi, pi], then fold into [-pi/2, pi/2] where the polynomial is accurate
+    float k = std::nearbyint(x * INV_TWO_PI);
+    x = x - k * TWO_PI_HI - k * TWO_PI_LO;
+    if (x > HALF_PI_F) {
+        x = PI_F - x;
+    } else if (x < -HALF_PI_F) {
+        x = -PI_F - x;
+    }
+    float x2 = x * x;
+    return x * (1.0f + x2 * (S3 + x2 * (S5 + x2 * (S7 + x2 * S9))));
+}
+
+void generatePathHeights(float* out, size_t count, float startY, float t0, float step, const PathShape& shape) {
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 vStep = _mm256_set1_ps(step);
+    const __m256 vT0 = _mm256_set1_ps(t0);
+    const __m256 vStartY = _mm256_set1_ps(startY);
+    const __m256 vFreq = _mm256_set1_ps(shape.frequency);
+    const __m256 vPhase = _mm256_set1_ps(shape.phase);
+    const __m256 vAmp = _mm256_set1_ps(shape.amplitude);
+    const __m256 vSlope = _mm256_set1_ps(shape.slope);
+    for (; i + 8 <= count; i += 8) {
+        __m256 idx = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lane);
+        __m256 t = _mm256_add_ps(vT0, _mm256_mul_ps(idx, vStep));
+        __m256 s = fastSin8(_mm256_add_ps(_mm256_mul_ps(t, vFreq), vPhase));
+        __m256 base = _mm256_add_ps(vStartY, _mm256_mul_ps(vSlope, t));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(base, _mm256_mul_ps(vAmp, s)));
+    }
+#elif defined(__SSE2__)
+    const __m128 lane = _mm_setr_ps(0, 1, 2, 3);
+    const __m128 vStep = _mm_set1_ps(step);
+    const __m128 vT0 = _mm_set1_ps(t0);
+    const __m128 vStartY = _mm_set1_ps(startY);
+    const __m128 vFreq = _mm_set1_ps(shape.frequency);
+    const __m128 vPhase = _mm_set1_ps(shape.phase);
+    const __m128 vAmp = _mm_set1_ps(shape.amplitude);
+    const __m128 vSlope = _mm_set1_ps(shape.slope);
+    for (; i + 4 <= count; i += 4) {
+        __m128 idx = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane);
+        __m128 t = _mm_add_ps(vT0, _mm_mul_ps(idx, vStep));
+        __m128 s = fastSin4(_mm_add_ps(_mm_mul_ps(t, vFreq), vPhase));
+        __m128 base = _mm_add_ps(vStartY, _mm_mul_ps(vSlope, t));
+        _mm_storeu_ps(out + i, _mm_add_ps(base, _mm_mul_ps(vAmp, s)));
+    }
+#endif
+
+    // Scalar fallback, and the tail of the vector loops
+    for (; i < count; ++i) {
+        float t = t0 + static_cast<float>(i) * step;
+        out[i] = startY + shape.slope * t + shape.amplitude * fastSin(t * shape.frequency + shape.phase);
+    }
+}
+
+void generatePathHeightsScalar(float* out, size_t count, float startY, float t0, float step, const PathShape& shape) {
+    for (size_t i = 0; i < count; ++i) {
+        float t = t0 + static_cast<float>(i) * step;
+        out[i] = startY + shape.slope * t + shape.amplitude * fastSin(t * shape.frequency + shape.phase);
+    }
+}
+
+void generatePathHeightsReference(float* out, size_t count, float startY, float t0, float step, const PathShape& shape) {
+    for (size_t i = 0; i < count; ++i) {
+        float t = t0 + static_cast<float>(i) * step;
+        out[i] = startY + shape.slope * t + shape.amplitude * std::sin(t * shape.frequency + shape.phase);
+    }
+}
\ No newline at end of file
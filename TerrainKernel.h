@@ -0,0 +1,35 @@
+#ifndef TERRAINKERNEL_H
+#define TERRAINKERNEL_H
+
+#include <cstddef>
+
+// Every path type is one sine wave on a straight incline:
+// y = startY + slope * t + amplitude * sin(frequency * t + phase),
+// where t is the distance from the start of the segment, in pixels
+struct PathShape {
+    float amplitude;
+    float frequency;
+    float phase;
+    float slope = 0.0f;
+};
+
+PathShape pathShape(int pathType);
+
+// Polynomial sine with range reduction; accurate to a few 1e-6 over the ranges used here
+float fastSin(float x);
+
+// Writes count heights in pixels, for samples t = t0 + i * step. Only y is
+// computed; x is implied by the sample index. Uses AVX or SSE2 when the build
+// targets them, with a scalar loop for the rest. Every lane does the same IEEE
+// operations in the same order as the scalar loop, so as long as the compiler
+// does not fuse them (build with -ffp-contract=off, as run.sh and bench.sh do)
+// the output is bit for bit the same on every build and replays carry over.
+void generatePathHeights(float* out, size_t count, float startY, float t0, float step, const PathShape& shape);
+
+// The scalar loop alone, for checking that the vector paths match it exactly
+void generatePathHeightsScalar(float* out, size_t count, float startY, float t0, float step, const PathShape& shape);
+
+// Same output computed with std::sin, for accuracy checks
+void generatePathHeightsReference(float* out, size_t count, float startY, float t0, float step, const PathShape& shape);
+
+#endif // TERRAINKERNEL_H
\ No newline at end of file
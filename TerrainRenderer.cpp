@@ -0,0 +1,63 @@
+#include "TerrainRenderer.h"
+#include "Bicycle.h"
+#include <algorithm>
+#include <cmath>
+
+void TerrainRenderer::appendStripVertices(const TerrainChunk& chunk, size_t k, float startX) {
+    // Extrude vertex k into the thick ground line, with the normal taken from its
+    // neighbours (the ghost vertices at chunk ends, so strips meet without a seam)
+    const Heightfield& h = chunk.heights;
+    const std::vector<uint16_t>& v = chunk.vertices;
+    sf::Vector2f before = k > 0 ? sf::Vector2f(h.sampleX(v[k - 1]), h.sampleY(v[k - 1]))
+                                : sf::Vector2f(chunk.prevGhost.x * SCALE, chunk.prevGhost.y * SCALE);
+    sf::Vector2f after = k + 1 < v.size() ? sf::Vector2f(h.sampleX(v[k + 1]), h.sampleY(v[k + 1]))
+                                          : sf::Vector2f(chunk.nextGhost.x * SCALE, chunk.nextGhost.y * SCALE);
+    sf::Vector2f tangent = after - before;
+    float length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y);
+    float halfThickness = TERRAIN_LINE_THICKNESS / 2.0f;
+    sf::Vector2f normal(-tangent.y / length * halfThickness, tangent.x / length * halfThickness);
+    sf::Vector2f center(startX + h.sampleX(v[k]), h.sampleY(v[k]));
+    strip.append(sf::Vertex(center + normal, sf::Color::Green));
+    strip.append(sf::Vertex(center - normal, sf::Color::Green));
+}
+
+void TerrainRenderer::render(sf::RenderTarget& target, const std::vector<ChunkHandle>& chunks, int originChunk) {
+    // Build one strip from just the vertices inside the view, straight from the heightfields
+    const sf::View& view = target.getView();
+    float left = view.getCenter().x - view.getSize().x / 2.0f;
+    float right = view.getCenter().x + view.getSize().x / 2.0f;
+    // Two strip vertices for every sample in view plus one beyond each edge, were they all kept.
+    // clear() keeps the storage, so once sized the strip is rebuilt without allocating
+    size_t worstCase = 2 * (static_cast<size_t>(view.getSize().x / TERRAIN_STEP) + 4);
+    if (worstCase > reservedVertices) {
+        strip.resize(worstCase);
+        reservedVertices = worstCase;
+    }
+    strip.clear();
+    for (const ChunkHandle& chunk : chunks) {
+        // Chunk heightfields start at x = 0; this is where the chunk sits in the world
+        const Heightfield& h = chunk->heights;
+        float startX = (chunk->index - originChunk) * SEGMENT_LENGTH;
+        if (startX + h.getEndX() < left || startX > right) {
+            continue;
+        }
+        // Vertices are sorted sample indices; include one beyond each view edge
+        const std::vector<uint16_t>& v = chunk->vertices;
+        float firstSample = std::max((left - startX) / h.getStep(), 0.0f);
+        float lastSample = std::max((right - startX) / h.getStep(), 0.0f);
+        auto firstIt = std::upper_bound(v.begin(), v.end(), static_cast<uint16_t>(std::min(firstSample, 65535.0f)));
+        auto lastIt = std::lower_bound(v.begin(), v.end(), static_cast<uint16_t>(std::min(std::ceil(lastSample), 65535.0f)));
+        size_t begin = firstIt == v.begin() ? 0 : firstIt - v.begin() - 1;
+        size_t end = lastIt == v.end() ? v.size() : lastIt - v.begin() + 1;
+        // The seam vertex was already added as the previous chunk's last one
+        if (begin == 0 && strip.getVertexCount() > 0) {
+            begin = 1;
+        }
+        for (size_t k = begin; k < end; ++k) {
+            appendStripVertices(*chunk, k, startX);
+        }
+    }
+    if (strip.getVertexCount() > 0) {
+        target.draw(strip);
+    }
+}
\ No newline at end of file
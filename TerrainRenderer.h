@@ -0,0 +1,25 @@
+#ifndef TERRAINRENDERER_H
+#define TERRAINRENDERER_H
+
+#include "TerrainGenerator.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Draws terrain chunks as one thick green strip. Only reads immutable chunks,
+// so it can run on the render thread while the simulation thread moves on.
+class TerrainRenderer {
+public:
+    // chunks must be contiguous and in x order, as Terrain::getChunkHandles gives them;
+    // chunk i is drawn at (i - originChunk) * SEGMENT_LENGTH, as Terrain places it
+    void render(sf::RenderTarget& target, const std::vector<ChunkHandle>& chunks, int originChunk);
+
+private:
+    // Rebuilt every frame from just the vertices in view
+    sf::VertexArray strip{sf::TriangleStrip};
+    // Vertices the strip has room for; it is grown to the worst case for the view up front
+    size_t reservedVertices = 0;
+
+    void appendStripVertices(const TerrainChunk& chunk, size_t k, float startX);
+};
+
+#endif // TERRAINRENDERER_H
\ No newline at end of file
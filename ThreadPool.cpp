@@ -0,0 +1,92 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Spread tasks round-robin; idle workers steal whatever is left unbalanced
+    Worker& worker = *workers[nextWorker++ % workers.size()];
+    unfinished++;
+    {
+        // Counted under the deque's lock, so queued never runs behind what can be popped
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+        queued++;
+    }
+    {
+        // A worker between checking queued and sleeping holds this, so the notify can't slip past it
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    allDone.wait(lock, [this] { return unfinished == 0; });
+}
+
+bool ThreadPool::runOne(unsigned index) {
+    // Own deque first (newest task), then steal the oldest task of another worker
+    std::function<void()> task;
+    for (size_t offset = 0; offset < workers.size() && !task; ++offset) {
+        Worker& worker = *workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        } else {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+        // Taken off the count as it leaves the deque, so idle workers don't see it as still waiting
+        queued--;
+    }
+    if (!task) {
+        return false;
+    }
+
+    task();
+    if (--unfinished == 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        allDone.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    while (true) {
+        if (runOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: each worker has its own task deque, takes work from
+// its back and, when empty, steals from the front of the other workers'.
+class ThreadPool {
+public:
+    // 0 threads means one per hardware core
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    // Blocks until every submitted task has finished
+    void wait();
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> unfinished{0};
+    std::atomic<unsigned> nextWorker{0};
+    bool stopping = false;
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    void workerLoop(unsigned index);
+    bool runOne(unsigned index);
+};
+
+#endif // THREADPOOL_H
\ No newline at end of file
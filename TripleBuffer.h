@@ -0,0 +1,40 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+// Hands the latest value from one writer thread to one reader thread without
+// locks. The writer fills back() and publishes it; the reader picks up the
+// newest published value with update(). Each side owns one slot and they trade
+// through the third, so neither ever waits for the other or sees a torn value.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side
+    T& back() { return slots[backIndex]; }
+    void publish() {
+        backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader side; returns true if a newer value was swapped in
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr unsigned INDEX_MASK = 3;
+    static constexpr unsigned FRESH = 4;
+
+    std::array<T, 3> slots;
+    unsigned backIndex = 0;
+    std::atomic<unsigned> middle{1};
+    unsigned frontIndex = 2;
+};
+
+#endif // TRIPLEBUFFER_H
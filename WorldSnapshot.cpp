@@ -0,0 +1,16 @@
+#include "WorldSnapshot.h"
+
+SnapshotRing::SnapshotRing(size_t capacity, size_t ghostCount) : slots(capacity) {
+    for (WorldSnapshot& slot : slots) {
+        slot.ghosts.resize(ghostCount);
+    }
+}
+
+void SnapshotRing::push() {
+    // When full, the slot just written was the oldest one
+    if (count == slots.size()) {
+        first = (first + 1) % slots.size();
+    } else {
+        count++;
+    }
+}
\ No newline at end of file
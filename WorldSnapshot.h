@@ -0,0 +1,42 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include "Bicycle.h"
+#include <cstddef>
+#include <vector>
+
+// A moment of a run, enough to put a Simulation back to it (see
+// Simulation::restoreSnapshot). Terrain needs only the floating origin, as
+// chunks are a pure function of (seed, index), and scripted ghost input is a
+// pure function of the step, so there is no generator or RNG state to keep.
+struct WorldSnapshot {
+    unsigned long step = 0;
+    int score = 0;
+    int originChunk = 0;
+    BikeState player;
+    // One per ghost; a disabled ghost has crashed
+    std::vector<BikeState> ghosts;
+};
+
+// The last capacity snapshots, newest on top. All storage is allocated by the
+// constructor; pushing overwrites the oldest snapshot in place.
+class SnapshotRing {
+public:
+    SnapshotRing(size_t capacity, size_t ghostCount);
+    // The slot the next snapshot is written to; push() commits it
+    WorldSnapshot& next() { return slots[(first + count) % slots.size()]; }
+    void push();
+    // The most recent snapshot still held, removed with pop()
+    const WorldSnapshot& newest() const { return slots[(first + count - 1) % slots.size()]; }
+    void pop() { count--; }
+    void clear() { count = 0; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+private:
+    std::vector<WorldSnapshot> slots;
+    size_t first = 0;
+    size_t count = 0;
+};
+
+#endif // WORLDSNAPSHOT_H
\ No newline at end of file
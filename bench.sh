@@ -0,0 +1,11 @@
+#!/bin/bash
+# Builds the benchmark suite from every game source except main.cpp, counting allocations
+# -ffp-contract=off keeps the terrain bit for bit the same as the game's build (see TerrainKernel.h)
+g++ -fdiagnostics-color=always -O2 -march=native -g -pthread -ffp-contract=off -DTRACK_ALLOCATIONS -I. \
+    $(ls *.cpp | grep -v '^main\.cpp$') bench/*.cpp \
+    -lsfml-graphics -lsfml-window -lsfml-system -lGL \
+    -lbox2d \
+    -o bench_main
+
+export DISPLAY=${DISPLAY:-:0}
+./bench_main "$@"
@@ -0,0 +1,531 @@
+#include "AllocationTracker.h"
+#include "GameFrame.h"
+#include "InputSource.h"
+#include "LandingPredictor.h"
+#include "ResourceCache.h"
+#include "RiderBatch.h"
+#include "SceneRenderer.h"
+#include "Simulation.h"
+#include "SimulationThread.h"
+#include "Terrain.h"
+#include "TerrainKernel.h"
+#include "TerrainRenderer.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Allocations per op come from the counting operator new in AllocationTracker.cpp
+#ifndef TRACK_ALLOCATIONS
+#error "Build the benchmarks with -DTRACK_ALLOCATIONS (bench.sh does)"
+#endif
+
+// --- Harness ---
+
+struct BenchResult {
+    std::string name;
+    long param;
+    unsigned long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+};
+
+static std::vector<BenchResult> results;
+
+// Times op() over a fixed number of iterations, or for at least ~0.2 s when iterations is 0
+static void measure(const std::string& name, long param, unsigned long iterations, const std::function<void()>& op) {
+    using Clock = std::chrono::steady_clock;
+    const double minSeconds = 0.2;
+
+    unsigned long done = 0;
+    AllocationStats before = threadAllocations();
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    while (iterations ? done < iterations : elapsed < minSeconds) {
+        op();
+        done++;
+        if (!iterations && done % 16 == 0) {
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+    }
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    BenchResult result;
+    result.name = name;
+    result.param = param;
+    result.iterations = done;
+    result.nsPerOp = elapsed * 1e9 / done;
+    AllocationStats after = threadAllocations();
+    result.allocsPerOp = static_cast<double>(after.count - before.count) / done;
+    result.bytesPerOp = static_cast<double>(after.bytes - before.bytes) / done;
+    results.push_back(result);
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << param
+              << std::setw(14) << std::fixed << std::setprecision(1) << result.nsPerOp << " ns/op"
+              << std::setw(10) << std::setprecision(2) << result.allocsPerOp << " allocs/op"
+              << std::setw(12) << std::setprecision(0) << result.bytesPerOp << " B/op" << std::endl;
+}
+
+static void writeJson(const std::string& path) {
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"param\": " << r.param
+            << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp
+            << ", \"allocs_per_op\": " << r.allocsPerOp
+            << ", \"bytes_per_op\": " << r.bytesPerOp << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    std::cout << "Wrote " << path << std::endl;
+}
+
+// --- Benchmarks ---
+
+static void benchGeneratePath() {
+    // One segment per op into a reused buffer, over increasing segment lengths
+    std::vector<float> heights;
+    for (long length : {1000L, 10000L, 100000L}) {
+        size_t count = static_cast<size_t>(length / TERRAIN_STEP) + 1;
+        heights.resize(count);
+        measure("terrain.generatePath", length, 0, [&heights, count] {
+            generatePathHeights(heights.data(), count, 350.0f, 0.0f, TERRAIN_STEP, pathShape(2));
+        });
+    }
+
+    // The std::sin version of the same kernel, for comparison
+    std::vector<float> reference;
+    for (long length : {1000L, 10000L, 100000L}) {
+        size_t count = static_cast<size_t>(length / TERRAIN_STEP) + 1;
+        reference.resize(count);
+        measure("terrain.generatePathScalar", length, 0, [&reference, count] {
+            generatePathHeightsReference(reference.data(), count, 350.0f, 0.0f, TERRAIN_STEP, pathShape(2));
+        });
+    }
+}
+
+// Compares the vectorized kernel against std::sin for every path type, and bit for bit against
+// its scalar loop; returns false if it drifts or differs
+static bool checkKernelAccuracy() {
+    const float tolerance = 0.01f; // pixels
+    float worst = 0.0f;
+    // The vector paths must match the scalar loop exactly, or a replay recorded on one build
+    // would ride different terrain on another
+    size_t mismatches = 0;
+    for (int pathType = 0; pathType < 4; ++pathType) {
+        for (size_t count : {1, 3, 7, 8, 9, 201, 20001}) {
+            for (float t0 : {0.0f, 5.0f, 12345.0f}) {
+                std::vector<float> fast(count);
+                std::vector<float> scalar(count);
+                std::vector<float> reference(count);
+                generatePathHeights(fast.data(), count, 350.0f, t0, TERRAIN_STEP, pathShape(pathType));
+                generatePathHeightsScalar(scalar.data(), count, 350.0f, t0, TERRAIN_STEP, pathShape(pathType));
+                generatePathHeightsReference(reference.data(), count, 350.0f, t0, TERRAIN_STEP, pathShape(pathType));
+                for (size_t i = 0; i < count; ++i) {
+                    worst = std::max(worst, std::abs(fast[i] - reference[i]));
+                    if (std::memcmp(&fast[i], &scalar[i], sizeof(float)) != 0) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    bool ok = worst <= tolerance;
+    std::cout << "terrain kernel accuracy: max error " << worst << " px (tolerance " << tolerance << ") "
+              << (ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "terrain kernel vs scalar: " << mismatches << " samples differ "
+              << (mismatches == 0 ? "OK" : "FAILED") << std::endl;
+    return ok && mismatches == 0;
+}
+
+// Compares adaptive vertex selection with uniform sampling over many chunks; returns false
+// if the adaptive chain strays further than TERRAIN_TOLERANCE from the sampled curve
+static bool checkTerrainSampling() {
+    const int chunkCount = 1000;
+    TerrainGenerator generator(1);
+    std::vector<uint16_t> uniform30;
+    double adaptiveVertices = 0.0;
+    double uniformVertices = 0.0;
+    float adaptiveError = 0.0f;
+    float uniform30Error = 0.0f;
+    for (int i = 0; i < chunkCount; ++i) {
+        TerrainChunk chunk = generator.generate(i);
+        const Heightfield& h = chunk.heights;
+        uniform30.clear();
+        for (size_t s = 0; s < h.size(); s += 6) {
+            uniform30.push_back(static_cast<uint16_t>(s));
+        }
+        if (uniform30.back() != h.size() - 1) {
+            uniform30.push_back(static_cast<uint16_t>(h.size() - 1));
+        }
+        adaptiveVertices += chunk.vertices.size();
+        uniformVertices += uniform30.size();
+        adaptiveError = std::max(adaptiveError, h.maxDeviation(chunk.vertices));
+        uniform30Error = std::max(uniform30Error, h.maxDeviation(uniform30));
+    }
+
+    // Every chain edge is a broadphase proxy, and every vertex is two strip vertices per frame
+    size_t samples = static_cast<size_t>(SEGMENT_LENGTH / TERRAIN_STEP) + 1;
+    std::cout << std::fixed << std::setprecision(3)
+              << "terrain sampling over " << chunkCount << " chunks (error against the " << TERRAIN_STEP << " px samples):\n"
+              << "  every sample   " << std::setw(7) << std::setprecision(1) << static_cast<double>(samples)
+              << " vertices/chunk  max error 0.000 px\n"
+              << "  every 30 px    " << std::setw(7) << uniformVertices / chunkCount
+              << " vertices/chunk  max error " << std::setprecision(3) << uniform30Error << " px\n"
+              << "  adaptive       " << std::setw(7) << std::setprecision(1) << adaptiveVertices / chunkCount
+              << " vertices/chunk  max error " << std::setprecision(3) << adaptiveError << " px (tolerance "
+              << TERRAIN_TOLERANCE << ")" << std::endl;
+    return adaptiveError <= TERRAIN_TOLERANCE;
+}
+
+// Runs the game's per-frame work over a scripted ride: a physics step, the render snapshot,
+// GameFrame's update (score, camera, landing prediction) and, if an offscreen target is
+// available, its drawing. Returns false if any frame after warm-up allocates on this
+// thread. Frames that restart after a crash are exempt; chunks are generated on the
+// terrain worker, and Box2D allocates from its own pools
+static bool checkFrameAllocations() {
+    const unsigned long warmupFrames = 600;
+    const unsigned long checkedFrames = 7200;
+    const unsigned ghostCount = 20;
+    Simulation sim(1, BikeParams(), true);
+    addScriptedGhosts(sim, ghostCount, 1);
+    ScriptedInput input(40, 20);
+    RenderSnapshot snapshot;
+    // The same per-frame code Game runs, so allocations added there are caught here
+    GameFrame frame(ghostCount);
+    sf::RenderTexture target;
+    bool canRender = target.create(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    AllocationMeter meter;
+    unsigned long restarts = 0;
+    for (unsigned long i = 0; i < warmupFrames + checkedFrames; ++i) {
+        if (i == warmupFrames) {
+            meter.begin();
+        }
+        sim.step(input.isSpacePressed(sim.getStepCount()));
+        bool restarted = sim.checkCrash() != CrashReason::None;
+        if (restarted) {
+            sim.reset();
+            restarts++;
+        }
+        captureSnapshot(sim, snapshot);
+        snapshot.run = static_cast<unsigned>(restarts);
+        snapshot.crash = CrashReason::None;
+        frame.update(snapshot, 1.0f, PHYSICS_TIMESTEP);
+        if (canRender) {
+            frame.draw(target, snapshot, 1.0f);
+            target.display();
+        }
+        if (i >= warmupFrames) {
+            if (restarted) {
+                meter.begin();
+            } else {
+                meter.endFrame();
+            }
+        }
+    }
+
+    bool ok = meter.getAllocatingFrames() == 0;
+    meter.print(canRender ? "steady-state frames" : "steady-state frames (not drawn: no offscreen target)");
+    std::cout << "frame allocations over " << restarts << " restarts: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+static void benchGenerateChunk() {
+    // A whole chunk: heights, vertex selection and ghost vertices
+    TerrainGenerator generator(1);
+    int index = 0;
+    measure("terrain.generateChunk", 0, 0, [&generator, &index] {
+        TerrainChunk chunk = generator.generate(index++);
+        if (chunk.vertices.empty()) {
+            std::abort();
+        }
+    });
+}
+
+static void benchExtend() {
+    // One chunk appended per op, after travelling `history` chunks
+    for (long history : {10L, 100L, 1000L, 5000L}) {
+        b2World world(b2Vec2(0.0f, 9.8f));
+        Terrain terrain(&world, 1);
+        while (static_cast<long>(terrain.getEndX() / SEGMENT_LENGTH) < history) {
+            terrain.extendIfNeeded(terrain.getEndX());
+        }
+        measure("terrain.extendIfNeeded", history, 200, [&terrain] {
+            terrain.extendIfNeeded(terrain.getEndX());
+        });
+    }
+}
+
+static void benchJumpTo() {
+    // Regenerating the window around a far point of the track, with nothing cached
+    b2World world(b2Vec2(0.0f, 9.8f));
+    Terrain terrain(&world, 1);
+    float x = 0.0f;
+    measure("terrain.jumpTo", 0, 200, [&terrain, &x] {
+        x += 100.0f * SEGMENT_LENGTH;
+        terrain.jumpTo(x);
+    });
+}
+
+static void benchHeightAt() {
+    // Ground queries spread over the loaded terrain
+    b2World world(b2Vec2(0.0f, 9.8f));
+    Terrain terrain(&world, 1);
+    float x = 0.0f;
+    float sum = 0.0f;
+    measure("terrain.heightAt", 0, 0, [&terrain, &x, &sum] {
+        sum += terrain.heightAt(x) + terrain.slopeAt(x);
+        x = x + 37.0f < terrain.getEndX() ? x + 37.0f : 0.0f;
+    });
+    if (std::isnan(sum)) {
+        std::abort();
+    }
+}
+
+static long residentKb() {
+    // Second field of /proc/self/statm, in pages
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    if (!(statm >> size >> resident)) {
+        return -1;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static void benchFontLoading() {
+    // Before the cache every text user (Game, GameOverUI) parsed the font file itself; now
+    // the first getFont loads it and every later user gets the same font back
+    measure("font.loadFromFile", 0, 50, [] {
+        sf::Font font;
+        if (!font.loadFromFile(DEFAULT_FONT)) {
+            std::abort();
+        }
+    });
+    // What EMBED_FONT does: no file I/O, the face is read from memory already mapped
+    std::ifstream file(DEFAULT_FONT, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    measure("font.loadFromMemory", 0, 50, [&data] {
+        sf::Font font;
+        if (!font.loadFromMemory(data.data(), data.size())) {
+            std::abort();
+        }
+    });
+    ResourceCache::instance().getFont(DEFAULT_FONT);
+    measure("font.cacheHit", 0, 0, [] {
+        if (ResourceCache::instance().getFont(DEFAULT_FONT).getInfo().family.empty()) {
+            std::abort();
+        }
+    });
+
+    // Memory each separately loaded font keeps, with the glyphs the score uses rendered;
+    // the cache keeps one however many users there are
+    const int fontCount = 8;
+    long before = residentKb();
+    std::vector<std::unique_ptr<sf::Font>> fonts;
+    for (int i = 0; i < fontCount; ++i) {
+        fonts.emplace_back(new sf::Font());
+        if (!fonts.back()->loadFromFile(DEFAULT_FONT)) {
+            std::abort();
+        }
+        for (char c : std::string("0123456789Score: GameOvr!")) {
+            fonts.back()->getGlyph(static_cast<sf::Uint32>(c), 48, false);
+        }
+    }
+    long after = residentKb();
+    if (before >= 0 && after >= 0) {
+        std::cout << "font memory: " << (after - before) / fontCount << " KB resident per separately loaded font"
+                  << std::endl;
+    }
+}
+
+static void benchRender() {
+    // CPU cost of submitting the visible terrain to an offscreen target, from the chunk handles a snapshot carries
+    sf::RenderTexture target;
+    TerrainRenderer renderer;
+    std::vector<ChunkHandle> chunks;
+    if (!target.create(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+        std::cout << "terrain.render skipped: no offscreen render target available" << std::endl;
+        return;
+    }
+    for (long history : {3L, 100L, 1000L}) {
+        b2World world(b2Vec2(0.0f, 9.8f));
+        Terrain terrain(&world, 1);
+        while (static_cast<long>(terrain.getEndX() / SEGMENT_LENGTH) < history) {
+            terrain.extendIfNeeded(terrain.getEndX());
+        }
+        sf::View view(sf::FloatRect(terrain.getEndX() - SEGMENT_LENGTH - SCREEN_WIDTH, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+        target.setView(view);
+        terrain.getChunkHandles(chunks);
+        measure("terrain.render", history, 0, [&renderer, &chunks, &target, &terrain] {
+            renderer.render(target, chunks, terrain.getOriginChunk());
+        });
+        target.display();
+    }
+}
+
+static void benchStep() {
+    // One Bicycle::updatePhysics + world.Step per op, restarting after a crash
+    Simulation sim(1);
+    ScriptedInput input(40, 20);
+    measure("simulation.step", 0, 0, [&sim, &input] {
+        sim.step(input.isSpacePressed(sim.getStepCount()));
+        if (sim.checkCrash() != CrashReason::None) {
+            sim.reset();
+        }
+    });
+}
+
+static void benchStepGhosts() {
+    // One step with N scripted ghosts sharing the world, restarting when the player crashes
+    for (long ghosts : {0L, 100L, 300L}) {
+        Simulation sim(1);
+        addScriptedGhosts(sim, static_cast<unsigned>(ghosts), 1);
+        ScriptedInput input(40, 20);
+        measure("simulation.stepGhosts", ghosts, 0, [&sim, &input] {
+            sim.step(input.isSpacePressed(sim.getStepCount()));
+            if (sim.checkCrash() != CrashReason::None) {
+                sim.reset();
+            }
+        });
+    }
+}
+
+static void benchRiders() {
+    // Rebuilding the rider batch, and drawing it with one call to an offscreen target
+    sf::RenderTexture target;
+    bool canRender = target.create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (long count : {1L, 100L, 500L}) {
+        RiderBatch riders;
+        auto build = [&riders, count] {
+            riders.clear();
+            for (long i = 0; i < count; ++i) {
+                riders.add(sf::Vector2f(100.0f + i % SCREEN_WIDTH, 300.0f), 0.01f * i, GHOST_STYLE);
+            }
+        };
+        measure("riders.build", count, 0, build);
+        if (canRender) {
+            measure("riders.render", count, 0, [&riders, &target] {
+                riders.render(target);
+            });
+            target.display();
+        }
+    }
+    if (!canRender) {
+        std::cout << "riders.render skipped: no offscreen render target available" << std::endl;
+    }
+}
+
+static void benchCheckCrash() {
+    // The per-step crash check (Game::checkGameOver's logic) with the bike resting on the ground
+    Simulation sim(1);
+    for (int i = 0; i < 120; ++i) {
+        sim.step(false);
+    }
+    measure("simulation.checkCrash", 0, 0, [&sim] {
+        if (sim.checkCrash() == CrashReason::FellOffScreen) {
+            std::abort();
+        }
+    });
+}
+
+static void benchSnapshot() {
+    // Saving and restoring a run with 20 ghosts, as the rewind ring does; neither should allocate
+    Simulation sim(1);
+    addScriptedGhosts(sim, 20, 1);
+    ScriptedInput input(40, 20);
+    for (int i = 0; i < 300; ++i) {
+        sim.step(input.isSpacePressed(sim.getStepCount()));
+    }
+    WorldSnapshot snapshot;
+    snapshot.ghosts.resize(sim.getGhosts().size());
+    measure("simulation.saveSnapshot", 20, 0, [&sim, &snapshot] {
+        sim.saveSnapshot(snapshot);
+    });
+    measure("simulation.restoreSnapshot", 20, 0, [&sim, &snapshot] {
+        sim.restoreSnapshot(snapshot);
+    });
+}
+
+static void benchLandingPrediction() {
+    // The predictor fed every step of a scripted ride, as Game feeds it every frame, and
+    // scored against where the bike really touched down. A steady hold isolates the clone's
+    // own error; the alternating script adds the cost of assuming Space stays as it is
+    const unsigned long steps = 36000;
+    struct Script {
+        const char* label;
+        unsigned long hold;
+        unsigned long release;
+    };
+    for (const Script& script : {Script{"holding Space", 1, 0}, Script{"script 40/20", 40, 20}}) {
+        Simulation sim(1, BikeParams(), true);
+        ScriptedInput input(script.hold, script.release);
+        LandingPredictor predictor;
+        PredictionAccuracy accuracy;
+        RenderSnapshot snapshot;
+        unsigned run = 0;
+        for (unsigned long i = 0; i < steps; ++i) {
+            sim.step(input.isSpacePressed(sim.getStepCount()));
+            captureSnapshot(sim, snapshot);
+            snapshot.run = run;
+            snapshot.crash = sim.checkCrash();
+            if (snapshot.crash == CrashReason::None) {
+                predictor.submit(snapshot);
+            }
+            accuracy.observe(snapshot, predictor.latest());
+            if (snapshot.crash != CrashReason::None) {
+                sim.reset();
+                run++;
+            }
+        }
+        std::cout << "landing prediction, " << script.label << ":" << std::endl;
+        predictor.printStats("  cost per step");
+        accuracy.print("  accuracy");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string jsonPath = "bench_results.json";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--json FILE]" << std::endl;
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (!checkKernelAccuracy() || !checkTerrainSampling() || !checkFrameAllocations()) {
+        return 1;
+    }
+    benchGeneratePath();
+    benchGenerateChunk();
+    benchExtend();
+    benchJumpTo();
+    benchHeightAt();
+    benchFontLoading();
+    benchRender();
+    benchStep();
+    benchStepGhosts();
+    benchRiders();
+    benchCheckCrash();
+    benchSnapshot();
+    benchLandingPrediction();
+    writeJson(jsonPath);
+    return 0;
+}
\ No newline at end of file
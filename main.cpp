@@ -1,8 +1,158 @@
+#include "BatchRunner.h"
+#include "CaptureRunner.h"
 #include "Game.h"
+#include "HeadlessRunner.h"
+#include "InputSource.h"
+#include "Profiler.h"
+#include "RunRecording.h"
+#include "SoakRunner.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --headless            Run the simulation without a window as fast as possible\n"
+              << "  --steps N             Stop a headless run after N physics steps (default 36000)\n"
+              << "  --soak HOURS          Simulate HOURS of riding headless and check memory, step time and physics stay flat\n"
+              << "  --script HOLD REL     Drive input by holding Space for HOLD steps, releasing for REL\n"
+              << "  --seed N              Seed for terrain generation (random by default)\n"
+              << "  --record FILE         Record the seed and per-step input of the first run to FILE\n"
+              << "  --replay FILE         Play back a recorded run, with its seed\n"
+              << "  --batch N             Run N parallel rollouts with randomly perturbed bike constants\n"
+              << "  --threads N           Worker threads for --batch (default: one per core)\n"
+              << "  --ghosts N            Race against N ghost riders with randomized scripted input\n"
+              << "  --capture FILE        Capture frames to FILE (.y4m, or a pattern like frames/%05d.png);\n"
+              << "                        with --headless, render offline one frame per step\n"
+              << "  --predict-thread      Predict landings on a worker thread instead of within each frame\n"
+              << "  --no-vsync            Render as fast as possible instead of at the display's refresh rate\n"
+              << "  --trace FILE          Profiler builds: write the frame trace to FILE on exit (.json or .csv)\n"
+              << "  --help                Show this message" << std::endl;
+}
 
 // Entry point for the game
-int main() {
-    Game game;
-    game.run();
+int main(int argc, char* argv[]) {
+    bool headless = false;
+    double soakHours = 0.0;
+    unsigned long maxSteps = 36000;
+    bool stepsGiven = false;
+    bool scripted = false;
+    unsigned long holdSteps = 0;
+    unsigned long releaseSteps = 0;
+    uint32_t seed = std::random_device{}();
+    std::string recordPath;
+    std::string replayPath;
+    unsigned batchRollouts = 0;
+    unsigned threadCount = 0;
+    unsigned ghostCount = 0;
+    bool vsync = VSYNC_ENABLED;
+    std::string tracePath = "profile_trace.json";
+    std::string capturePath;
+    bool predictOnWorker = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            soakHours = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            maxSteps = std::strtoul(argv[++i], nullptr, 10);
+            stepsGiven = true;
+        } else if (std::strcmp(argv[i], "--script") == 0 && i + 2 < argc) {
+            scripted = true;
+            holdSteps = std::strtoul(argv[++i], nullptr, 10);
+            releaseSteps = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchRollouts = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--ghosts") == 0 && i + 1 < argc) {
+            ghostCount = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capturePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--predict-thread") == 0) {
+            predictOnWorker = true;
+        } else if (std::strcmp(argv[i], "--no-vsync") == 0) {
+            vsync = false;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (batchRollouts > 0) {
+        runParameterSweep(batchRollouts, threadCount, seed, stepsGiven ? maxSteps : 3600);
+        return 0;
+    }
+
+    KeyboardInput keyboard;
+    ScriptedInput script(holdSteps, releaseSteps);
+    InputSource* input = scripted ? static_cast<InputSource*>(&script) : &keyboard;
+
+    // A replay brings its own seed and input
+    RunRecording replay;
+    ReplayInput replayInput(replay);
+    if (!replayPath.empty()) {
+        if (!replay.load(replayPath)) {
+            return 1;
+        }
+        seed = replay.getSeed();
+        input = &replayInput;
+        if (!stepsGiven) {
+            maxSteps = replay.getStepCount();
+        }
+    }
+
+    RunRecording recording(seed);
+    RecordingInput recordingInput(*input, recording);
+    if (!recordPath.empty()) {
+        input = &recordingInput;
+    }
+
+    std::cout << "Seed: " << seed << std::endl;
+
+    if ((headless || soakHours > 0.0) && !scripted && replayPath.empty()) {
+        std::cerr << "Headless runs need scripted input (--script HOLD REL) or a replay" << std::endl;
+        return 1;
+    }
+    if (soakHours > 0.0) {
+        return runSoakTest(*input, seed, soakHours) ? 0 : 1;
+    }
+    if (headless && !capturePath.empty()) {
+        if (!runCapture(*input, seed, ghostCount, maxSteps, capturePath)) {
+            return 1;
+        }
+    } else if (headless) {
+        HeadlessRunner runner(*input, maxSteps, seed);
+        printHeadlessStats(runner.run());
+    } else {
+        FrameCapture capture(SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (!capturePath.empty() && !capture.open(capturePath)) {
+            return 1;
+        }
+        Game game(*input, seed, ghostCount, vsync, capturePath.empty() ? nullptr : &capture, predictOnWorker);
+        game.run();
+        capture.finish();
+    }
+
+#ifdef ENABLE_PROFILER
+    Profiler::instance().exportTrace(tracePath);
+#else
+    (void)tracePath;
+#endif
+
+    if (!recordPath.empty() && !recording.save(recordPath)) {
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
@@ -1,8 +1,27 @@
 #!/bin/bash
-g++ -fdiagnostics-color=always -g *.cpp \
-    -lsfml-graphics -lsfml-window -lsfml-system \
+# PROFILE=1 builds in the frame profiler (F3 overlay, trace written on exit)
+# EMBED_FONT=1 compiles DejaVuSans.ttf into the binary instead of loading it at startup
+# QUANTIZE_TERRAIN=1 stores terrain heights as 16-bit fixed point instead of floats
+# TRACK_ALLOCATIONS=1 counts heap allocations per frame and per physics step, printed on exit
+FLAGS=""
+if [ "$PROFILE" = "1" ]; then
+    FLAGS="-DENABLE_PROFILER"
+fi
+if [ "$EMBED_FONT" = "1" ]; then
+    FLAGS="$FLAGS -DEMBED_FONT"
+fi
+if [ "$QUANTIZE_TERRAIN" = "1" ]; then
+    FLAGS="$FLAGS -DQUANTIZE_TERRAIN"
+fi
+if [ "$TRACK_ALLOCATIONS" = "1" ]; then
+    FLAGS="$FLAGS -DTRACK_ALLOCATIONS"
+fi
+
+# No fused multiply-adds, so terrain (and replays) come out the same whatever the target CPU
+g++ -fdiagnostics-color=always -g -pthread -ffp-contract=off $FLAGS *.cpp \
+    -lsfml-graphics -lsfml-window -lsfml-system -lGL \
     -lbox2d \
     -o main
 
 export DISPLAY=:0
-./main
+./main "$@"